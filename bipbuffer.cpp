@@ -0,0 +1,207 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#include <string.h>
+
+#include "generic/generic.hpp"
+#include "generic/bipbuffer.hpp"
+
+/**
+ * The top bit of the head and the tail index, toggled on every wrap around.
+ */
+#define BIPBUFFER_LAP                   (~((size_t)-1 >> 1))
+
+BipBuffer::BipBuffer(void) :
+      pData(0)
+    , Size(0)
+    , ResPos(0)
+    , ResSize(0)
+    , Head(0)
+    , Last(0)
+    , Tail(0)
+{
+
+}
+
+BipBuffer::BipBuffer(char *buf, size_t siz) :
+      pData(buf)
+    , Size(siz)
+    , ResPos(0)
+    , ResSize(0)
+    , Head(0)
+    , Last(0)
+    , Tail(0)
+{
+
+}
+
+void BipBuffer::init(char *buf, size_t siz)
+{
+    pData = buf;
+    Size = siz;
+    ResPos = 0;
+    ResSize = 0;
+    Head = 0;
+    Last = 0;
+    Tail = 0;
+}
+
+size_t BipBuffer::getSize(void)
+{
+    return Size;
+}
+
+size_t BipBuffer::getUsed(void)
+{
+    size_t head = loadAcquire(Head);
+    size_t last = loadAcquire(Last);
+    size_t tail = loadAcquire(Tail);
+
+    if (((head ^ tail) & BIPBUFFER_LAP) == 0)
+        return head - tail;
+
+    return (last - (tail & ~BIPBUFFER_LAP)) + (head & ~BIPBUFFER_LAP);
+}
+
+void *BipBuffer::reserve(size_t siz)
+{
+    size_t head = Head;
+    size_t tail = loadAcquire(Tail);
+    size_t pos = head & ~BIPBUFFER_LAP;
+    size_t end = tail & ~BIPBUFFER_LAP;
+
+    ResSize = 0;
+
+    if (siz == 0)
+        return 0;
+
+    /* The consumer has read all data of the previous lap and is about to 
+     * follow to the start of the buffer. */
+    if (((head ^ tail) & BIPBUFFER_LAP) != 0 && end == Last)
+    {
+        tail = head & BIPBUFFER_LAP;
+        end = 0;
+    }
+
+    if (((head ^ tail) & BIPBUFFER_LAP) == 0)
+    {
+        /* 
+         * Use the end of the buffer if possible, otherwise wrap around and 
+         * use the space up to the tail, or all of it if the buffer is empty.
+         */
+        if (Size - pos >= siz)
+            ResPos = pos;
+        else if (siz <= end || (head == tail && siz <= Size))
+            ResPos = 0;
+        else
+            return 0;
+    }
+    else
+    {
+        if (end - pos >= siz)
+            ResPos = pos;
+        else
+            return 0;
+    }
+
+    ResSize = siz;
+
+    return &pData[ResPos];
+}
+
+void BipBuffer::commit(size_t siz)
+{
+    size_t head = Head;
+
+    siz = min(siz, ResSize);
+    ResSize = 0;
+
+    if (siz == 0)
+        return;
+
+    if (ResPos != (head & ~BIPBUFFER_LAP))
+    {
+        /* Wrapped around, the consumer has to stop at the old head and then 
+         * follow to the next lap. */
+        storeRelease(Last, head & ~BIPBUFFER_LAP);
+        storeRelease(Head, siz | (~head & BIPBUFFER_LAP));
+    }
+    else
+    {
+        storeRelease(Head, head + siz);
+    }
+}
+
+size_t BipBuffer::write(const void *buf, size_t siz)
+{
+    void *blk = reserve(siz);
+
+    if (blk == 0)
+        return 0;
+
+    memcpy(blk, buf, siz);
+    commit(siz);
+
+    return siz;
+}
+
+size_t BipBuffer::getReadBlock(void **buf)
+{
+    size_t head = loadAcquire(Head);
+    size_t tail = Tail;
+    size_t last = 0;
+
+    if (((head ^ tail) & BIPBUFFER_LAP) != 0)
+    {
+        last = loadAcquire(Last);
+
+        if ((tail & ~BIPBUFFER_LAP) != last)
+        {
+            *buf = &pData[tail & ~BIPBUFFER_LAP];
+            return last - (tail & ~BIPBUFFER_LAP);
+        }
+
+        /* All data up to the wrap around has been consumed. */
+        tail = head & BIPBUFFER_LAP;
+        storeRelease(Tail, tail);
+    }
+
+    if (head == tail)
+        return 0;
+
+    *buf = &pData[tail & ~BIPBUFFER_LAP];
+
+    return head - tail;
+}
+
+void BipBuffer::free(size_t siz)
+{
+    void *buf = 0;
+    size_t avail = getReadBlock(&buf);
+
+    siz = min(siz, avail);
+
+    if (siz == 0)
+        return;
+
+    storeRelease(Tail, Tail + siz);
+}
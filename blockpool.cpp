@@ -0,0 +1,133 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#include "generic/generic.hpp"
+#include "generic/blockpool.hpp"
+
+/**
+ * Number of bits used for the block index in the free stack head.
+ */
+#define BLOCKPOOL_IDX_BITS              (sizeof(size_t) * 4)
+
+/**
+ * Mask of the block index in the free stack head.
+ */
+#define BLOCKPOOL_IDX_MASK              (((size_t)1 << BLOCKPOOL_IDX_BITS) - 1)
+
+/**
+ * Increment of the tag in the free stack head.
+ */
+#define BLOCKPOOL_TAG_INC               ((size_t)1 << BLOCKPOOL_IDX_BITS)
+
+BlockPool::BlockPool(void) :
+      pMem(0)
+    , BlkSize(0)
+    , Count(0)
+    , FreeCount(0)
+    , FreeHead(0)
+{
+
+}
+
+BlockPool::BlockPool(void *mem, size_t siz, size_t blkSize)
+{
+    init(mem, siz, blkSize);
+}
+
+void BlockPool::init(void *mem, size_t siz, size_t blkSize)
+{
+    size_t align = sizeof(void *);
+    size_t skip = (align - (uintptr_t)mem % align) % align;
+
+    /* The links are stored at the block starts, so they have to be aligned. */
+    pMem = (char *)mem + skip;
+    siz = siz > skip ? siz - skip : 0;
+    BlkSize = ((max(blkSize, align) + align - 1) / align) * align;
+    Count = min(siz / BlkSize, BLOCKPOOL_IDX_MASK);
+    FreeCount = Count;
+    FreeHead = 0;
+
+    /* Link all blocks, the first block becomes the head of the stack. */
+    for (size_t i = Count; i > 0; i--)
+    {
+        *((size_t *)&pMem[(i - 1) * BlkSize]) = FreeHead;
+        FreeHead = i;
+    }
+}
+
+size_t BlockPool::getBlockSize(void)
+{
+    return BlkSize;
+}
+
+size_t BlockPool::getCount(void)
+{
+    return Count;
+}
+
+size_t BlockPool::getFree(void)
+{
+    return loadRelaxed(FreeCount);
+}
+
+void *BlockPool::alloc(void)
+{
+    size_t head = loadAcquire(FreeHead);
+    size_t next = 0;
+    size_t idx = 0;
+    char *blk = 0;
+
+    do
+    {
+        idx = head & BLOCKPOOL_IDX_MASK;
+        if (idx == 0)
+            return 0;
+
+        /* 
+         * The block might be taken and overwritten by another thread at any
+         * time, in this case the tag makes the exchange below fail.
+         */
+        blk = &pMem[(idx - 1) * BlkSize];
+        next = loadRelaxed(*((size_t *)blk)) & BLOCKPOOL_IDX_MASK;
+    }
+    while (!compareExchange(FreeHead, head, 
+            next | ((head + BLOCKPOOL_TAG_INC) & ~BLOCKPOOL_IDX_MASK)));
+
+    subRelaxed(FreeCount, 1);
+
+    return blk;
+}
+
+void BlockPool::free(void *blk)
+{
+    size_t idx = ((char *)blk - pMem) / BlkSize + 1;
+    size_t head = loadRelaxed(FreeHead);
+
+    do
+    {
+        storeRelaxed(*((size_t *)blk), head & BLOCKPOOL_IDX_MASK);
+    }
+    while (!compareExchange(FreeHead, head, 
+            idx | ((head + BLOCKPOOL_TAG_INC) & ~BLOCKPOOL_IDX_MASK)));
+
+    addRelaxed(FreeCount, 1);
+}
@@ -0,0 +1,225 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#include <string.h>
+
+#include "generic/generic.hpp"
+#include "generic/broadcastfifo.hpp"
+
+BroadcastFifo::Reader::Reader(void) :
+      pFifo(0)
+    , pNext(0)
+    , Tail(0)
+{
+
+}
+
+BroadcastFifo::Reader::~Reader(void)
+{
+    if (pFifo)
+        pFifo->detach(*this);
+}
+
+size_t BroadcastFifo::Reader::getUsed(void)
+{
+    size_t head = 0;
+    size_t tail = Tail;
+
+    if (pFifo == 0)
+        return 0;
+
+    head = loadAcquire(pFifo->Head);
+
+    if (head >= tail)
+        return head - tail;
+
+    return head + (pFifo->Size - tail);
+}
+
+size_t BroadcastFifo::Reader::read(void *buf, size_t siz)
+{
+    size_t tmp = 0;
+    void *blk = 0;
+
+    /* Two blocks at most, as the data might wrap around. */
+    for (int i = 0; i < 2 && tmp < siz; i++)
+    {
+        size_t len = getReadBlock(&blk);
+
+        len = min(len, siz - tmp);
+
+        memcpy(((char *)buf) + tmp, blk, len);
+        free(len);
+        tmp += len;
+    }
+
+    return tmp;
+}
+
+size_t BroadcastFifo::Reader::getReadBlock(void **buf)
+{
+    size_t used = getUsed();
+
+    if (used == 0)
+        return 0;
+
+    *buf = &pFifo->pData[Tail];
+
+    return min(used, pFifo->Size - Tail);
+}
+
+void BroadcastFifo::Reader::free(size_t siz)
+{
+    size_t used = getUsed();
+    size_t tail = Tail;
+
+    siz = min(siz, used);
+
+    if (siz == 0)
+        return;
+
+    tail += siz;
+
+    if (tail >= pFifo->Size)
+    {
+        tail -= pFifo->Size;
+    }
+
+    storeRelease(Tail, tail);
+}
+
+BroadcastFifo::BroadcastFifo(void) :
+      pData(0)
+    , Size(0)
+    , pReaders(0)
+    , CachedFree(0)
+    , Head(0)
+{
+
+}
+
+BroadcastFifo::BroadcastFifo(char *buf, size_t siz) :
+      pData(buf)
+    , Size(siz)
+    , pReaders(0)
+    , CachedFree(0)
+    , Head(0)
+{
+
+}
+
+void BroadcastFifo::init(char *buf, size_t siz)
+{
+    pData = buf;
+    Size = siz;
+    pReaders = 0;
+    CachedFree = 0;
+    Head = 0;
+}
+
+void BroadcastFifo::attach(Reader &reader)
+{
+    if (reader.pFifo)
+        reader.pFifo->detach(reader);
+
+    reader.pFifo = this;
+    reader.Tail = Head;
+    reader.pNext = pReaders;
+    pReaders = &reader;
+    CachedFree = 0;
+}
+
+void BroadcastFifo::detach(Reader &reader)
+{
+    Reader **pp = &pReaders;
+
+    while (*pp && *pp != &reader)
+    {
+        pp = &(*pp)->pNext;
+    }
+
+    if (*pp)
+        *pp = reader.pNext;
+
+    reader.pFifo = 0;
+    reader.pNext = 0;
+    CachedFree = 0;
+}
+
+size_t BroadcastFifo::getSize(void)
+{
+    return Size;
+}
+
+size_t BroadcastFifo::getFree(void)
+{
+    size_t head = Head;
+    size_t used = 0;
+    size_t tail = 0;
+    size_t tmp = 0;
+
+    for (Reader *r = pReaders; r; r = r->pNext)
+    {
+        tail = loadAcquire(r->Tail);
+        tmp = head >= tail ? head - tail : head + (Size - tail);
+        used = max(used, tmp);
+    }
+
+    CachedFree = Size - used - 1;
+
+    return CachedFree;
+}
+
+size_t BroadcastFifo::write(const void *buf, size_t siz)
+{
+    size_t head = Head;
+    size_t tmp = 0;
+
+    if (siz > CachedFree)
+        getFree();
+
+    siz = min(siz, CachedFree);
+
+    if (siz == 0)
+        return 0;
+
+    tmp = min(siz, Size - head);
+    memcpy(&pData[head], buf, tmp);
+    memcpy(pData, ((const char *)buf) + tmp, siz - tmp);
+
+    head += siz;
+
+    if (head >= Size)
+    {
+        head -= Size;
+    }
+
+    CachedFree -= siz;
+    storeRelease(Head, head);
+
+    return siz;
+}
+
+size_t BroadcastFifo::put(const void *c)
+{
+    return write(c, 1);
+}
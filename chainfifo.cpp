@@ -0,0 +1,181 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#include <string.h>
+
+#include "generic/generic.hpp"
+#include "generic/chainfifo.hpp"
+
+ChainFifo::ChainFifo(BlockPool &pool) :
+      pPool(&pool)
+    , SegSize(pool.getBlockSize() - sizeof(Segment))
+    , pLast(0)
+    , Written(0)
+    , pFirst(0)
+    , ReadPos(0)
+    , Consumed(0)
+{
+
+}
+
+ChainFifo::~ChainFifo(void)
+{
+    Segment *seg = pFirst;
+    Segment *next = 0;
+
+    while (seg)
+    {
+        next = seg->pNext;
+        pPool->free(seg);
+        seg = next;
+    }
+}
+
+size_t ChainFifo::getUsed(void)
+{
+    size_t consumed = loadAcquire(Consumed);
+    size_t written = loadAcquire(Written);
+
+    /* The consumer may take bytes before the producer has counted them. */
+    if (consumed > written)
+        return 0;
+
+    return written - consumed;
+}
+
+size_t ChainFifo::write(const void *buf, size_t siz)
+{
+    size_t done = 0;
+    size_t fill = 0;
+    size_t tmp = 0;
+    Segment *seg = 0;
+
+    while (done < siz)
+    {
+        if (pLast == 0 || pLast->Fill == SegSize)
+        {
+            seg = (Segment *)pPool->alloc();
+            if (seg == 0)
+                break;
+
+            seg->pNext = 0;
+            seg->Fill = 0;
+
+            if (pLast)
+                storeRelease(pLast->pNext, seg);
+            else
+                storeRelease(pFirst, seg);
+
+            pLast = seg;
+        }
+
+        fill = pLast->Fill;
+        tmp = min(siz - done, SegSize - fill);
+        memcpy(&getData(pLast)[fill], ((const char *)buf) + done, tmp);
+        storeRelease(pLast->Fill, fill + tmp);
+        done += tmp;
+    }
+
+    storeRelease(Written, Written + done);
+
+    return done;
+}
+
+size_t ChainFifo::read(void *buf, size_t siz)
+{
+    return consume(buf, siz);
+}
+
+size_t ChainFifo::getReadBlock(void **buf)
+{
+    Segment *seg = getFirst();
+
+    if (seg == 0)
+        return 0;
+
+    *buf = &getData(seg)[ReadPos];
+
+    return loadAcquire(seg->Fill) - ReadPos;
+}
+
+void ChainFifo::free(size_t siz)
+{
+    consume(0, siz);
+}
+
+void ChainFifo::clear(void)
+{
+    consume(0, (size_t)-1);
+}
+
+char *ChainFifo::getData(Segment *seg)
+{
+    return ((char *)seg) + sizeof(Segment);
+}
+
+ChainFifo::Segment *ChainFifo::getFirst(void)
+{
+    Segment *seg = loadAcquire(pFirst);
+    Segment *next = 0;
+
+    while (seg && ReadPos == SegSize)
+    {
+        next = loadAcquire(seg->pNext);
+        if (next == 0)
+            break;
+
+        pFirst = next;
+        ReadPos = 0;
+        pPool->free(seg);
+        seg = next;
+    }
+
+    return seg;
+}
+
+size_t ChainFifo::consume(void *buf, size_t siz)
+{
+    size_t done = 0;
+    size_t tmp = 0;
+    Segment *seg = 0;
+
+    while (done < siz && (seg = getFirst()) != 0)
+    {
+        tmp = loadAcquire(seg->Fill) - ReadPos;
+        tmp = min(siz - done, tmp);
+
+        if (tmp == 0)
+            break;
+
+        if (buf)
+            memcpy(((char *)buf) + done, &getData(seg)[ReadPos], tmp);
+
+        ReadPos += tmp;
+        done += tmp;
+    }
+
+    /* Return the last drained segment right away if possible. */
+    getFirst();
+    storeRelease(Consumed, Consumed + done);
+
+    return done;
+}
@@ -22,6 +22,24 @@
 
 #include "generic/crc8.hpp"
 
+/**
+ * @brief Multiplies a and b modulo the given polynom.
+ */
+static uint8_t mulMod(uint8_t a, uint8_t b, uint8_t poly)
+{
+    uint8_t res = 0;
+
+    for (int i = 7; i >= 0; i--)
+    {
+        res = (res & 0x80) ? (res << 1) ^ poly : res << 1;
+
+        if ((b >> i) & 1)
+            res ^= a;
+    }
+
+    return res;
+}
+
 crc8::crc8(uint8_t val, uint8_t poly) :
       value(val)
     , polynom(poly)
@@ -66,6 +84,25 @@ uint8_t crc8::calc(void* pData, size_t siz)
     return value;
 }
 
+uint8_t crc8::combine(uint8_t crcA, uint8_t crcB, size_t lenB, uint8_t init,
+    uint8_t poly)
+{
+    /* x^8 mod poly, squared for every bit of lenB. */
+    uint8_t sq = poly;
+    uint8_t shift = 1;
+
+    while (lenB > 0)
+    {
+        if (lenB & 1)
+            shift = mulMod(shift, sq, poly);
+
+        sq = mulMod(sq, sq, poly);
+        lenB >>= 1;
+    }
+
+    return mulMod(crcA ^ init, shift, poly) ^ crcB;
+}
+
 crc8::operator uint8_t() 
 {
     return value;
@@ -0,0 +1,185 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+/*
+ * Measures how MpmcQueue scales with the number of threads compared to a Fifo
+ * guarded by a mutex. For 1 to N producer / consumer pairs, every producer
+ * pushes its share of the elements and the consumers pop them until all 
+ * elements have been passed. N defaults to the number of cores.
+ *
+ * This is a host program, it is not part of the library build:
+ *
+ *  g++ -std=gnu++11 -O2 -I../.. mpmcqueue.cpp ../../fifo.cpp -lpthread
+ *  ./a.out [pairs] [elements]
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "generic/fifo.hpp"
+#include "generic/mpmcqueue.hpp"
+
+#define BENCH_QUEUE_SIZE        1024
+
+/**
+ * A Fifo made safe for any number of producers and consumers by a mutex.
+ */
+class LockedFifo
+{
+    public:
+
+        LockedFifo() :
+              Queue(Data, sizeof(Data))
+        {
+
+        }
+
+        bool push(const uint64_t &val)
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+
+            if (Queue.getFree() < sizeof(val))
+                return false;
+
+            Queue.write(&val, sizeof(val));
+            return true;
+        }
+
+        bool pop(uint64_t &val)
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+
+            if (Queue.getUsed() < sizeof(val))
+                return false;
+
+            Queue.read(&val, sizeof(val));
+            return true;
+        }
+
+    private:
+
+        std::mutex Lock;
+
+        char Data[BENCH_QUEUE_SIZE * sizeof(uint64_t) + 1];
+
+        Fifo Queue;
+};
+
+/**
+ * Used to pass the given number of elements through the queue.
+ *
+ * @param queue     The queue to test.
+ * @param pairs     The number of producer and of consumer threads.
+ * @param cnt       The number of elements to pass.
+ *
+ * @return          The number of elements passed per microsecond, 0 if the 
+ *                  consumers did not get the sum of the written elements.
+ */
+template <typename Q> double run(Q &queue, unsigned pairs, uint64_t cnt)
+{
+    std::vector<std::thread> threads;
+    uint64_t popped = 0;
+    uint64_t sum = 0;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::duration<double, std::micro> us;
+
+    start = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; i < pairs; i++)
+    {
+        threads.emplace_back([&queue, i, pairs, cnt]()
+        {
+            for (uint64_t val = i + 1; val <= cnt; val += pairs)
+            {
+                while (!queue.push(val))
+                    std::this_thread::yield();
+            }
+        });
+
+        threads.emplace_back([&queue, &popped, &sum, cnt]()
+        {
+            uint64_t val = 0;
+            uint64_t tmp = 0;
+
+            while (__atomic_load_n(&popped, __ATOMIC_RELAXED) < cnt)
+            {
+                if (!queue.pop(val))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                tmp += val;
+                __atomic_fetch_add(&popped, 1, __ATOMIC_RELAXED);
+            }
+
+            __atomic_fetch_add(&sum, tmp, __ATOMIC_RELAXED);
+        });
+    }
+
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    us = std::chrono::steady_clock::now() - start;
+
+    if (sum != cnt * (cnt + 1) / 2)
+        return 0;
+
+    return cnt / us.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned pairs = std::thread::hardware_concurrency();
+    uint64_t cnt = 2000000;
+
+    if (argc > 1)
+        pairs = atoi(argv[1]);
+
+    if (argc > 2)
+        cnt = strtoull(argv[2], 0, 0);
+
+    if (pairs == 0)
+        pairs = 1;
+
+    printf("%llu elements, queue size %u\n", (unsigned long long)cnt,
+        BENCH_QUEUE_SIZE);
+    printf("pairs  MpmcQueue [M/s]  Fifo + mutex [M/s]\n");
+
+    for (unsigned i = 1; i <= pairs; i++)
+    {
+        MpmcQueue<uint64_t, BENCH_QUEUE_SIZE> mpmc;
+        LockedFifo locked;
+
+        printf("%5u  %15.2f  %18.2f\n", i, run(mpmc, i, cnt), 
+            run(locked, i, cnt));
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+/*
+ * Measures the throughput of StaticFifo compared to Fifo of the same size, 
+ * with one producer and one consumer thread. Single bytes are passed by put()
+ * and get(), larger chunks by write() and read().
+ *
+ * This is a host program, it is not part of the library build:
+ *
+ *  g++ -std=gnu++11 -O2 -I../.. staticfifo.cpp ../../fifo.cpp -lpthread
+ *  ./a.out [bytes]
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <thread>
+
+#include "generic/fifo.hpp"
+#include "generic/staticfifo.hpp"
+
+#define BENCH_FIFO_SIZE         4096
+
+/**
+ * Used to pass the given number of bytes through the fifo.
+ *
+ * @param fifo      The fifo to test.
+ * @param chunk     The number of bytes per call, 1 to use put() and get().
+ * @param cnt       The number of bytes to pass.
+ *
+ * @return          The number of bytes passed per microsecond, 0 if the 
+ *                  consumer did not get the written data.
+ */
+template <typename F> double run(F &fifo, size_t chunk, size_t cnt)
+{
+    std::thread producer;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::duration<double, std::micro> us;
+    uint8_t buf[256];
+    size_t done = 0;
+    size_t len = 0;
+    bool ok = true;
+
+    start = std::chrono::steady_clock::now();
+
+    producer = std::thread([&fifo, chunk, cnt]()
+    {
+        uint8_t buf[256];
+        size_t done = 0;
+        size_t len = 0;
+
+        while (done < cnt)
+        {
+            len = chunk < cnt - done ? chunk : cnt - done;
+
+            for (size_t i = 0; i < len; i++)
+                buf[i] = (uint8_t)(done + i);
+
+            if (len == 1)
+                len = fifo.put(buf);
+            else
+                len = fifo.write(buf, len);
+
+            if (len == 0)
+                std::this_thread::yield();
+
+            done += len;
+        }
+    });
+
+    while (done < cnt)
+    {
+        if (chunk == 1)
+            len = fifo.get(buf);
+        else
+            len = fifo.read(buf, chunk);
+
+        if (len == 0)
+            std::this_thread::yield();
+
+        for (size_t i = 0; i < len; i++)
+            ok &= buf[i] == (uint8_t)(done + i);
+
+        done += len;
+    }
+
+    producer.join();
+    us = std::chrono::steady_clock::now() - start;
+
+    if (!ok)
+        return 0;
+
+    return cnt / us.count();
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t chunks[] = {1, 16, 64, 256};
+    static StaticFifo<BENCH_FIFO_SIZE> sfifo;
+    static char data[BENCH_FIFO_SIZE + 1];
+    static Fifo fifo(data, sizeof(data));
+    size_t cnt = 64 * 1024 * 1024;
+
+    if (argc > 1)
+        cnt = strtoull(argv[1], 0, 0);
+
+    printf("%zu bytes, fifo size %u\n", cnt, BENCH_FIFO_SIZE);
+    printf("chunk  StaticFifo [MB/s]  Fifo [MB/s]\n");
+
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++)
+    {
+        printf("%5zu  %17.2f  %11.2f\n", chunks[i], run(sfifo, chunks[i], cnt),
+            run(fifo, chunks[i], cnt));
+    }
+
+    return 0;
+}
@@ -26,47 +26,121 @@
 #include "generic/generic.hpp"
 #include "generic/fifo.hpp"
 
+/**
+ * Used to get the mask of the index bits of the read index, which covers 
+ * indices up to siz - 1.
+ */
+static size_t tailMask(size_t siz)
+{
+    size_t mask = 0;
+
+    while (mask < siz - 1 && mask != (size_t)-1)
+    {
+        mask = (mask << 1) | 1;
+    }
+
+    return mask;
+}
+
 Fifo::Fifo(void) :
       pData(0)
     , Size(0)
+    , TailMask(0)
+    , Mirrored(false)
+    , Overwrite(false)
     , Head(0)
+    , Dropped(0)
+    , Overruns(0)
     , Tail(0)
 {
-
+#ifdef FIFO_STATS
+    resetStats();
+#endif
 }
 
-Fifo::Fifo(char * buf, size_t size) :
+Fifo::Fifo(char * buf, size_t size, bool mirrored) :
       pData(buf)
     , Size(size)
+    , TailMask(tailMask(size))
+    , Mirrored(mirrored)
+    , Overwrite(false)
     , Head(0)
+    , Dropped(0)
+    , Overruns(0)
     , Tail(0)
 {
-
+#ifdef FIFO_STATS
+    resetStats();
+#endif
 }
 
-void Fifo::init(char * buf, size_t size)
+void Fifo::init(char * buf, size_t size, bool mirrored)
 {
     pData = buf;
     Size = size;
+    TailMask = tailMask(size);
+    Mirrored = mirrored;
+    storeRelaxed(Dropped, 0);
+    storeRelaxed(Overruns, 0);
+#ifdef FIFO_STATS
+    resetStats();
+#endif
     Head = 0;
     Tail = 0;
 }
 
+#ifdef FIFO_STATS
+void Fifo::getStats(FifoStats *stats)
+{
+    stats->HighWater = loadRelaxed(In.HighWater);
+    stats->BytesIn = loadRelaxed(In.BytesIn);
+    stats->BytesOut = loadRelaxed(Out.BytesOut);
+    stats->ShortWrites = loadRelaxed(In.ShortWrites);
+    stats->EmptyReads = loadRelaxed(Out.EmptyReads);
+    stats->MaxWrite = loadRelaxed(In.MaxWrite);
+}
+
+void Fifo::resetStats(void)
+{
+    memset(&In, 0, sizeof(In));
+    memset(&Out, 0, sizeof(Out));
+}
+#endif
+
 size_t Fifo::getSize(void)
 {
     return Size;
 }
 
-size_t Fifo::getUsed(void)
+void Fifo::setOverwrite(bool val)
 {
-    size_t used = 0;
+    Overwrite = val;
+}
 
-    if (Head >= Tail)
-        used = Head - Tail;
-    else
-        used = Head + (Size - Tail);
+bool Fifo::isOverwrite(void)
+{
+    return Overwrite;
+}
 
-    return used;
+size_t Fifo::getDropped(void)
+{
+    return loadRelaxed(Dropped);
+}
+
+size_t Fifo::getOverruns(void)
+{
+    return loadRelaxed(Overruns);
+}
+
+void Fifo::resetDropped(void)
+{
+    storeRelaxed(Dropped, 0);
+    storeRelaxed(Overruns, 0);
+}
+
+size_t Fifo::getUsed(void)
+{
+    return getUsed(loadAcquire(Tail) & TailMask);
 }
 
 size_t Fifo::getFree(void)
@@ -76,140 +150,470 @@ size_t Fifo::getFree(void)
 
 size_t Fifo::write(const void *buf, size_t siz)
 {
+    size_t head = Head;
+    size_t avail = getFree();
+    size_t skip = 0;
     size_t tmp = 0;
+#ifdef FIFO_STATS
+    size_t req = siz;
+#endif
 
-    siz = min(siz, getFree());
+    if (siz > avail && Overwrite)
+    {
+        /* Only the newest bytes are kept if the data exceeds the fifo. */
+        if (siz > Size - 1)
+        {
+            skip = siz - (Size - 1);
+            buf = ((char *)buf) + skip;
+            siz -= skip;
+            storeRelaxed(Dropped, Dropped + skip);
+        }
+
+        if (dropOldest(siz) + skip > 0)
+            storeRelaxed(Overruns, Overruns + 1);
+
+        avail = siz;
+    }
+
+    siz = min(siz, avail);
 
     if (siz == 0)
         goto out;
 
-    if (Head + siz > Size)
+    if (head + siz >= Size && !Mirrored)
     {
-        tmp = Size - Head;
-        memcpy(&pData[Head], buf, tmp);
+        tmp = Size - head;
+        memcpy(&pData[head], buf, tmp);
         siz -= tmp;
         buf = ((char *)buf) + tmp;
-        Head = 0;
+        head = 0;
     }
 
-    memcpy(&pData[Head], buf, siz);
-    Head += siz;
+    memcpy(&pData[head], buf, siz);
+    head += siz;
+
+    if (head >= Size)
+    {
+        head -= Size;
+    }
+
+    storeRelease(Head, head);
 
     out:
-    return siz + tmp;
+#ifdef FIFO_STATS
+    statsIn(req, siz + tmp + skip);
+#endif
+    return siz + tmp + skip;
+}
+
+size_t Fifo::getWriteBlock(void **buf)
+{
+    size_t head = Head;
+    size_t tail = loadAcquire(Tail);
+    size_t avail = 0;
+
+    if (Mirrored)
+        avail = getFree();
+    else if (head >= tail)
+        avail = Size - head - (tail == 0 ? 1 : 0);
+    else
+        avail = tail - head - 1;
+
+    if (avail == 0)
+        goto out;
+
+    *buf = &pData[head];
+
+    out:
+    return avail;
+}
+
+size_t Fifo::getWriteBlocks(FifoBlock blk[2])
+{
+    size_t head = Head;
+    size_t avail = getFree();
+
+    blk[0].pBuf = &pData[head];
+    blk[0].Size = avail;
+    blk[1].pBuf = pData;
+    blk[1].Size = 0;
+
+    if (head + avail > Size && !Mirrored)
+    {
+        blk[0].Size = Size - head;
+        blk[1].Size = avail - blk[0].Size;
+    }
+
+    return avail;
+}
+
+void Fifo::commit(size_t siz)
+{
+    size_t head = Head;
+    size_t avail = getFree();
+#ifdef FIFO_STATS
+    size_t req = siz;
+#endif
+
+    siz = min(siz, avail);
+
+    if (siz == 0)
+        goto out;
+
+    head += siz;
+
+    if (head >= Size)
+    {
+        head -= Size;
+    }
+
+    storeRelease(Head, head);
+
+    out:
+#ifdef FIFO_STATS
+    statsIn(req, siz);
+#endif
+    return;
 }
 
 size_t Fifo::put(const void *c)
 {
+    size_t head = Head;
     size_t tmp = 0;
 
     if (getFree() == 0)
-        goto out;
-
-    if (Head + 1 > Size)
     {
-        Head = 0;
+        if (!Overwrite)
+            goto out;
+
+        if (dropOldest(1) > 0)
+            storeRelaxed(Overruns, Overruns + 1);
     }
 
-    pData[Head++] = *((char*)c);
+    pData[head++] = *((char*)c);
     tmp = 1;
 
+    if (head == Size)
+    {
+        head = 0;
+    }
+
+    storeRelease(Head, head);
+
     out:
+#ifdef FIFO_STATS
+    statsIn(1, tmp);
+#endif
     return tmp;
 }
 
 size_t Fifo::get(void *buf)
 {
-    size_t siz = min(1, getUsed());
+    size_t tail = 0;
+    size_t idx = 0;
+    size_t siz = 0;
+    char c = 0;
 
-    if (siz == 0)
-        goto out;
+    /* Retry if the producer dropped the byte in overwrite mode. */
+    do
+    {
+        tail = loadAcquire(Tail);
+        idx = tail & TailMask;
+        siz = getUsed(idx);
 
-    *((char*)buf) = pData[Tail];
-    Tail++;
+        if (siz == 0)
+            goto out;
 
-    if (Tail == Size)
-    {
-        Tail = 0;
+        siz = 1;
+        c = pData[idx];
     }
+    while (!moveTail(tail, idx + 1 == Size ? 0 : idx + 1));
 
-    if (Tail == Head)
-    {
-        Head = 0;
-        Tail = 0;
-    }
+    *((char*)buf) = c;
 
     out:
+#ifdef FIFO_STATS
+    statsOut(1, siz);
+#endif
     return siz;
 }
 
 size_t Fifo::read(void *buf, size_t siz)
 {
+    size_t tail = 0;
+    size_t idx = 0;
+    size_t next = 0;
+    size_t len = 0;
     size_t tmp = 0;
 
-    siz = min(siz, getUsed());
-
-    if (siz == 0)
-        goto out;
-
-    if (Tail + siz > Size)
+    /* Retry if the producer dropped the data in overwrite mode, the copy might
+     * be overwritten. */
+    do
     {
-        tmp = Size - Tail;
-        memcpy(buf, (const void*) &pData[Tail], tmp);
-        siz -= tmp;
-        buf = ((char *)buf) + tmp;
-        Tail = 0;
+        tail = loadAcquire(Tail);
+        idx = tail & TailMask;
+        len = getUsed(idx);
+        len = min(siz, len);
+
+        if (len == 0)
+            goto out;
+
+        if (idx + len >= Size && !Mirrored)
+        {
+            tmp = Size - idx;
+            memcpy(buf, (const void*) &pData[idx], tmp);
+            memcpy(((char *)buf) + tmp, (const void*) pData, len - tmp);
+        }
+        else
+        {
+            memcpy(buf, (const void*) &pData[idx], len);
+        }
+
+        next = idx + len;
+
+        if (next >= Size)
+        {
+            next -= Size;
+        }
     }
+    while (!moveTail(tail, next));
 
-    memcpy(buf, (const void*) &pData[Tail], siz);
-    Tail += siz;
+    out:
+#ifdef FIFO_STATS
+    statsOut(siz, len);
+#endif
+    return len;
+}
 
-    if (Tail == Head)
+size_t Fifo::peek(void *buf, size_t siz, size_t offset)
+{
+    FifoBlock blk[2];
+    size_t used = getReadBlocks(blk);
+    size_t tmp = 0;
+
+    if (offset >= used)
+        return 0;
+
+    siz = min(siz, used - offset);
+
+    if (offset < blk[0].Size)
+    {
+        tmp = min(siz, blk[0].Size - offset);
+        memcpy(buf, ((char *)blk[0].pBuf) + offset, tmp);
+        offset = 0;
+    }
+    else
     {
-        Head = 0;
-        Tail = 0;
+        offset -= blk[0].Size;
     }
 
-    out:
-    return siz + tmp;
+    memcpy(((char *)buf) + tmp, ((char *)blk[1].pBuf) + offset, siz - tmp);
+
+    return siz;
+}
+
+size_t Fifo::find(char c, size_t siz)
+{
+    FifoBlock blk[2];
+    char *pos = 0;
+    size_t len = 0;
+
+    getReadBlocks(blk);
+
+    len = min(blk[0].Size, siz);
+    pos = (char *)memchr(blk[0].pBuf, c, len);
+    if (pos)
+        return pos - (char *)blk[0].pBuf + 1;
+
+    siz -= len;
+    len = min(blk[1].Size, siz);
+    pos = (char *)memchr(blk[1].pBuf, c, len);
+    if (pos)
+        return blk[0].Size + (pos - (char *)blk[1].pBuf) + 1;
+
+    return 0;
+}
+
+size_t Fifo::readUntil(void *buf, size_t siz, char delim)
+{
+    size_t len = getRecordLength(siz, delim);
+
+    if (len == 0)
+        return 0;
+
+    return read(buf, len);
+}
+
+size_t Fifo::peekUntil(void *buf, size_t siz, char delim)
+{
+    size_t len = getRecordLength(siz, delim);
+
+    if (len == 0)
+        return 0;
+
+    return peek(buf, len);
+}
+
+size_t Fifo::peekLine(void *buf, size_t siz)
+{
+    return peekUntil(buf, siz, '\n');
 }
 
 size_t Fifo::getReadBlock(void **buf)
 {
-    size_t used = getUsed();
+    size_t tail = loadAcquire(Tail) & TailMask;
+    size_t used = getUsed(tail);
 
     if (used == 0)
         goto out;
 
-    *buf = &pData[Tail];
+    *buf = &pData[tail];
 
-    if (Tail + used > Size)
+    if (tail + used > Size && !Mirrored)
     {
-        used = Size - Tail;
+        used = Size - tail;
     }
 
     out:
     return used;
 }
 
+size_t Fifo::getReadBlocks(FifoBlock blk[2])
+{
+    size_t tail = loadAcquire(Tail) & TailMask;
+    size_t used = getUsed(tail);
+
+    blk[0].pBuf = &pData[tail];
+    blk[0].Size = used;
+    blk[1].pBuf = pData;
+    blk[1].Size = 0;
+
+    if (tail + used > Size && !Mirrored)
+    {
+        blk[0].Size = Size - tail;
+        blk[1].Size = used - blk[0].Size;
+    }
+
+    return used;
+}
+
 void Fifo::free(size_t siz)
 {
-    size_t used = min(siz, getUsed());
+    size_t tail = 0;
+    size_t idx = 0;
+    size_t used = 0;
 
-    if (used == 0)
-        return;
+    do
+    {
+        tail = loadAcquire(Tail);
+        idx = tail & TailMask;
+        used = getUsed(idx);
+        used = min(siz, used);
+
+        if (used == 0)
+            break;
+    }
+    while (!moveTail(tail, idx + used >= Size ? idx + used - Size : 
+        idx + used));
+
+#ifdef FIFO_STATS
+    statsOut(siz, used);
+#endif
+}
+
+size_t Fifo::dropOldest(size_t siz)
+{
+    size_t head = Head;
+    size_t tail = 0;
+    size_t idx = 0;
+    size_t used = 0;
+    size_t drop = 0;
 
-    if ((Tail + used) >= Size)
+    /* The consumer may free data at the same time, so the tail is only moved 
+     * if it has not changed in between. */
+    do
     {
-        used -= Size - Tail;
-        Tail = 0;
+        tail = loadAcquire(Tail);
+        idx = tail & TailMask;
+        used = head >= idx ? head - idx : head + (Size - idx);
+
+        if (Size - 1 - used >= siz)
+            return 0;
+
+        drop = siz - (Size - 1 - used);
     }
+    while (!moveTail(tail, idx + drop >= Size ? idx + drop - Size : 
+        idx + drop));
+
+    storeRelaxed(Dropped, Dropped + drop);
 
-    Tail += used;
+    return drop;
+}
+
+size_t Fifo::getUsed(size_t tail)
+{
+    size_t head = loadAcquire(Head);
 
-    if (Tail == Head)
+    if (head >= tail)
+        return head - tail;
+
+    return head + (Size - tail);
+}
+
+bool Fifo::moveTail(size_t tail, size_t next)
+{
+    if (!Overwrite)
     {
-        Head = 0;
-        Tail = 0;
+        storeRelease(Tail, next);
+        return true;
     }
+
+    /* The bits above the index count the moves. Otherwise a read index which
+     * came back to the same position after Size bytes would match and a torn
+     * copy would be taken as valid. */
+    next += (tail & ~TailMask) + TailMask + 1;
+
+    return compareExchange(Tail, tail, next);
+}
+
+size_t Fifo::getRecordLength(size_t siz, char delim)
+{
+    size_t used = getUsed();
+    size_t len = 0;
+
+    if (siz == 0)
+        return 0;
+
+    len = find(delim, min(used, siz));
+
+    if (len == 0 && used >= siz)
+        return siz;
+
+    return len;
+}
+
+#ifdef FIFO_STATS
+void Fifo::statsIn(size_t req, size_t done)
+{
+    size_t used = getUsed();
+
+    storeRelaxed(In.BytesIn, In.BytesIn + done);
+
+    if (done < req)
+        storeRelaxed(In.ShortWrites, In.ShortWrites + 1);
+
+    if (done > In.MaxWrite)
+        storeRelaxed(In.MaxWrite, done);
+
+    if (used > In.HighWater)
+        storeRelaxed(In.HighWater, used);
+}
+
+void Fifo::statsOut(size_t req, size_t done)
+{
+    storeRelaxed(Out.BytesOut, Out.BytesOut + done);
+
+    if (done == 0 && req != 0)
+        storeRelaxed(Out.EmptyReads, Out.EmptyReads + 1);
 }
+#endif
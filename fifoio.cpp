@@ -0,0 +1,81 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <sys/uio.h>
+
+#include "generic/fifoio.hpp"
+
+/**
+ * Used to translate fifo blocks to the io vector used by readv() and writev().
+ * Returns the number of io vector entries in use.
+ */
+static int toIoVec(struct iovec iov[2], const FifoBlock blk[2])
+{
+    iov[0].iov_base = blk[0].pBuf;
+    iov[0].iov_len = blk[0].Size;
+    iov[1].iov_base = blk[1].pBuf;
+    iov[1].iov_len = blk[1].Size;
+
+    return blk[1].Size ? 2 : 1;
+}
+
+ssize_t fifoFill(Fifo &fifo, int fd)
+{
+    FifoBlock blk[2];
+    struct iovec iov[2];
+    ssize_t ret = 0;
+
+    if (fifo.getWriteBlocks(blk) == 0)
+    {
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    ret = readv(fd, iov, toIoVec(iov, blk));
+
+    if (ret > 0)
+        fifo.commit(ret);
+
+    return ret;
+}
+
+ssize_t fifoDrain(Fifo &fifo, int fd)
+{
+    FifoBlock blk[2];
+    struct iovec iov[2];
+    ssize_t ret = 0;
+
+    if (fifo.getReadBlocks(blk) == 0)
+        return 0;
+
+    ret = writev(fd, iov, toIoVec(iov, blk));
+
+    if (ret > 0)
+        fifo.free(ret);
+
+    return ret;
+}
+
+#endif /* __unix__ || __APPLE__ */
@@ -0,0 +1,207 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "generic/generic.hpp"
+#include "generic/crc8.hpp"
+#include "generic/filefifo.hpp"
+
+FileFifo::FileFifo(void) :
+      ShmFifo()
+    , Clean(false)
+    , SyncInterval(0)
+    , Dirty(0)
+{
+
+}
+
+FileFifo::~FileFifo(void)
+{
+    close();
+}
+
+bool FileFifo::open(const char *path, size_t siz)
+{
+    struct stat st;
+    int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+
+    close();
+
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size == 0)
+    {
+        if (!attach(fd, siz))
+            return false;
+
+        Checkpoint = true;
+        Clean = false;
+        sync();
+        return true;
+    }
+
+    if (!attach(fd, 0, false))
+        return false;
+
+    if (!recover())
+    {
+        ShmFifo::close();
+        return false;
+    }
+
+    Checkpoint = true;
+    return true;
+}
+
+void FileFifo::close(void)
+{
+    if (pHdr == 0)
+        return;
+
+    sync();
+    pHdr->Clean = 1;
+    msync(pHdr, sizeof(Header), MS_SYNC);
+
+    ShmFifo::close();
+}
+
+bool FileFifo::wasClean(void)
+{
+    return Clean;
+}
+
+void FileFifo::setSyncInterval(size_t siz)
+{
+    SyncInterval = siz;
+}
+
+bool FileFifo::sync(void)
+{
+    size_t head = loadAcquire(pHdr->Head);
+    size_t tail = loadAcquire(pHdr->Tail);
+
+    Dirty = 0;
+
+    /* All data up to head is in the mapping, flush it before the checkpoint. */
+    if (msync(pHdr, sizeof(Header) + Size, MS_SYNC) != 0)
+        return false;
+
+    pHdr->SyncHead = head;
+    pHdr->SyncCrc = getSyncCrc(head, tail);
+    storeRelease(pHdr->SyncTail, tail);
+
+    return msync(pHdr, sizeof(Header), MS_SYNC) == 0;
+}
+
+size_t FileFifo::write(const void *buf, size_t siz)
+{
+    makeRoom(siz);
+    siz = ShmFifo::write(buf, siz);
+    addDirty(siz);
+
+    return siz;
+}
+
+size_t FileFifo::getWriteBlock(void **buf)
+{
+    makeRoom(1);
+
+    return ShmFifo::getWriteBlock(buf);
+}
+
+void FileFifo::commit(size_t siz)
+{
+    size_t avail = getFree();
+
+    ShmFifo::commit(siz);
+    addDirty(min(siz, avail));
+}
+
+bool FileFifo::recover(void)
+{
+    if (!isCompatible(Size))
+        return false;
+
+    Clean = pHdr->Clean && isValid(Size);
+
+    if (!Clean)
+    {
+        if (pHdr->SyncHead < Size && pHdr->SyncTail < Size && 
+            pHdr->SyncCrc == getSyncCrc(pHdr->SyncHead, pHdr->SyncTail))
+        {
+            pHdr->Head = pHdr->SyncHead;
+            pHdr->Tail = pHdr->SyncTail;
+        }
+        else
+        {
+            pHdr->Head = 0;
+            pHdr->Tail = 0;
+        }
+    }
+
+    /* Cleared as long as the file is open, to detect a crash. It has to reach
+     * the disk before any index does, otherwise a crash would leave indices 
+     * marked as clean which do not match the data on disk. */
+    pHdr->Clean = 0;
+
+    return msync(pHdr, sizeof(Header), MS_SYNC) == 0;
+}
+
+uint32_t FileFifo::getSyncCrc(uint64_t head, uint64_t tail)
+{
+    crc8 crc;
+    uint64_t idx[2] = { head, tail };
+
+    return crc.calc(idx, sizeof(idx));
+}
+
+void FileFifo::makeRoom(size_t siz)
+{
+    if (getFree() >= siz)
+        return;
+
+    if (loadAcquire(pHdr->Tail) != loadAcquire(pHdr->SyncTail))
+        sync();
+}
+
+void FileFifo::addDirty(size_t siz)
+{
+    Dirty += siz;
+
+    if (SyncInterval && Dirty >= SyncInterval)
+        sync();
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,556 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#include <string.h>
+
+#include "generic/generic.hpp"
+#include "generic/framing.hpp"
+
+/**
+ * Returns the index of the first c in buf[from, siz), or siz if there is none.
+ */
+static size_t scan(const uint8_t *buf, size_t from, size_t siz, uint8_t c)
+{
+    const uint8_t *tmp = (const uint8_t *)memchr(buf + from, c, siz - from);
+
+    return tmp ? tmp - buf : siz;
+}
+
+/**
+ * Copies data to the given offset of two blocks of free fifo space.
+ */
+static void copyTo(const FifoBlock blk[2], size_t offset, const void *buf, 
+    size_t siz)
+{
+    size_t len = 0;
+
+    if (offset < blk[0].Size)
+    {
+        len = min(siz, blk[0].Size - offset);
+        memcpy((char *)blk[0].pBuf + offset, buf, len);
+        buf = (const char *)buf + len;
+        siz -= len;
+        offset = 0;
+    }
+    else
+    {
+        offset -= blk[0].Size;
+    }
+
+    memcpy((char *)blk[1].pBuf + offset, buf, siz);
+}
+
+FrameDecoder::FrameDecoder(void) :
+      Crc(0)
+    , Pending(0)
+    , Drop(false)
+    , Errors(0)
+{
+
+}
+
+void FrameDecoder::reset(void)
+{
+    Crc = 0;
+    Pending = 0;
+    Drop = false;
+}
+
+size_t FrameDecoder::getErrors(void)
+{
+    return Errors;
+}
+
+size_t FrameDecoder::store(Fifo &out, const FifoBlock blk[2], size_t avail, 
+    const void *buf, size_t siz)
+{
+    if (Drop || siz == 0)
+        return siz;
+
+    /* Only a frame which never fits is dropped, otherwise the caller stops 
+     * until the consumer of out has made room. */
+    if (Pending + siz > out.getSize() - 1)
+    {
+        error();
+        return siz;
+    }
+
+    siz = min(siz, avail - Pending);
+    copyTo(blk, Pending, buf, siz);
+    Crc.calc(buf, siz);
+    Pending += siz;
+
+    return siz;
+}
+
+void FrameDecoder::error(void)
+{
+    if (!Drop)
+        Errors++;
+
+    Drop = true;
+}
+
+size_t FrameDecoder::endFrame(Fifo &out)
+{
+    size_t len = 0;
+
+    if (Drop || Pending == 0)
+        goto out;
+
+    /* The crc over the payload and its crc is zero. */
+    if (Pending < 2 || (uint8_t)Crc != 0)
+    {
+        Errors++;
+        goto out;
+    }
+
+    len = Pending - 1;
+    out.commit(len);
+
+    out:
+    reset();
+    return len;
+}
+
+SlipEncoder::SlipEncoder(void) :
+      Crc(0)
+{
+
+}
+
+void SlipEncoder::reset(void)
+{
+    Crc = 0;
+}
+
+size_t SlipEncoder::encode(Fifo &in, Fifo &out, size_t siz)
+{
+    const uint8_t *buf = 0;
+    uint8_t esc[2] = { SLIP_ESC, 0 };
+    size_t done = 0;
+    size_t len = 0;
+    size_t end = 0;
+    size_t pos = 0;
+    size_t run = 0;
+    size_t i = 0;
+    bool full = false;
+
+    while (!full && done < siz && (len = in.getReadBlock((void **)&buf)) > 0)
+    {
+        len = min(len, siz - done);
+        end = scan(buf, 0, len, SLIP_END);
+        pos = scan(buf, 0, len, SLIP_ESC);
+        i = 0;
+
+        while (i < len)
+        {
+            if (end < i)
+                end = scan(buf, i, len, SLIP_END);
+
+            if (pos < i)
+                pos = scan(buf, i, len, SLIP_ESC);
+
+            /* Copy all bytes up to the next special byte at once. */
+            run = min(end, pos) - i;
+            run = out.write(buf + i, run);
+            Crc.calc(buf + i, run);
+            i += run;
+
+            if (i < min(end, pos))
+            {
+                full = true;
+                break;
+            }
+
+            if (i == len)
+                break;
+
+            if (out.getFree() < sizeof(esc))
+            {
+                full = true;
+                break;
+            }
+
+            esc[1] = buf[i] == SLIP_END ? SLIP_ESC_END : SLIP_ESC_ESC;
+            out.write(esc, sizeof(esc));
+            Crc.calc(buf[i]);
+            i++;
+        }
+
+        in.free(i);
+        done += i;
+    }
+
+    return done;
+}
+
+bool SlipEncoder::finish(Fifo &out)
+{
+    uint8_t buf[3] = { (uint8_t)Crc, SLIP_END, 0 };
+    size_t siz = 2;
+
+    if (buf[0] == SLIP_END || buf[0] == SLIP_ESC)
+    {
+        buf[1] = buf[0] == SLIP_END ? SLIP_ESC_END : SLIP_ESC_ESC;
+        buf[0] = SLIP_ESC;
+        buf[2] = SLIP_END;
+        siz = 3;
+    }
+
+    if (out.getFree() < siz)
+        return false;
+
+    out.write(buf, siz);
+    Crc = 0;
+
+    return true;
+}
+
+SlipDecoder::SlipDecoder(void) :
+      FrameDecoder()
+    , Esc(false)
+{
+
+}
+
+void SlipDecoder::reset(void)
+{
+    FrameDecoder::reset();
+    Esc = false;
+}
+
+size_t SlipDecoder::decode(Fifo &in, Fifo &out)
+{
+    FifoBlock blk[2];
+    size_t avail = out.getWriteBlocks(blk);
+    const uint8_t *buf = 0;
+    size_t len = 0;
+    size_t end = 0;
+    size_t pos = 0;
+    size_t res = 0;
+    size_t run = 0;
+    size_t tmp = 0;
+    size_t i = 0;
+
+    while ((len = in.getReadBlock((void **)&buf)) > 0)
+    {
+        i = 0;
+
+        /* The escape byte has been the last one of the previous block or the
+         * output fifo has been full. */
+        if (Esc)
+        {
+            if (buf[0] == SLIP_END)
+                error();
+            else if (unescape(out, blk, avail, buf[0]))
+                i = 1;
+            else
+                return 0;
+
+            Esc = false;
+        }
+
+        end = scan(buf, i, len, SLIP_END);
+        pos = scan(buf, i, len, SLIP_ESC);
+
+        while (i < len)
+        {
+            if (end < i)
+                end = scan(buf, i, len, SLIP_END);
+
+            if (pos < i)
+                pos = scan(buf, i, len, SLIP_ESC);
+
+            /* Store all bytes up to the next special byte at once. */
+            run = min(end, pos) - i;
+            tmp = store(out, blk, avail, buf + i, run);
+            i += tmp;
+
+            if (tmp < run)
+            {
+                in.free(i);
+                return 0;
+            }
+
+            if (i == len)
+                break;
+
+            if (buf[i] == SLIP_END)
+            {
+                i++;
+                Esc = false;
+                res = endFrame(out);
+
+                if (res > 0)
+                {
+                    in.free(i);
+                    return res;
+                }
+
+                continue;
+            }
+
+            i++;
+
+            if (i == len)
+            {
+                Esc = true;
+                break;
+            }
+
+            if (buf[i] == SLIP_END)
+            {
+                error();
+                continue;
+            }
+
+            if (!unescape(out, blk, avail, buf[i]))
+            {
+                Esc = true;
+                in.free(i);
+                return 0;
+            }
+
+            i++;
+        }
+
+        in.free(i);
+    }
+
+    return 0;
+}
+
+bool SlipDecoder::unescape(Fifo &out, const FifoBlock blk[2], size_t avail, 
+    uint8_t c)
+{
+    uint8_t tmp = 0;
+
+    switch (c)
+    {
+        case SLIP_ESC_END:
+            tmp = SLIP_END;
+            break;
+
+        case SLIP_ESC_ESC:
+            tmp = SLIP_ESC;
+            break;
+
+        default:
+            error();
+            return true;
+    }
+
+    return store(out, blk, avail, &tmp, 1) == 1;
+}
+
+CobsEncoder::CobsEncoder(void) :
+      Crc(0)
+    , Pending(0)
+{
+
+}
+
+void CobsEncoder::reset(void)
+{
+    Crc = 0;
+    Pending = 0;
+}
+
+size_t CobsEncoder::encode(Fifo &in, Fifo &out, size_t siz)
+{
+    const uint8_t *buf = 0;
+    size_t done = 0;
+    size_t len = 0;
+    size_t tmp = 0;
+
+    while (done < siz && (len = in.getReadBlock((void **)&buf)) > 0)
+    {
+        len = min(len, siz - done);
+        tmp = put(out, buf, len);
+        Crc.calc(buf, tmp);
+        in.free(tmp);
+        done += tmp;
+
+        if (tmp < len)
+            break;
+    }
+
+    return done;
+}
+
+bool CobsEncoder::finish(Fifo &out)
+{
+    FifoBlock blk[2];
+    uint8_t tmp = Crc;
+
+    /* The crc may close a full block and start a new one, then the last code 
+     * byte and the zero byte follow. */
+    if (out.getWriteBlocks(blk) < Pending + 5)
+        return false;
+
+    put(out, &tmp, 1);
+    out.getWriteBlocks(blk);
+    close(out, blk);
+
+    tmp = 0;
+    out.write(&tmp, 1);
+    Crc = 0;
+
+    return true;
+}
+
+size_t CobsEncoder::put(Fifo &out, const uint8_t *buf, size_t siz)
+{
+    FifoBlock blk[2];
+    size_t avail = out.getWriteBlocks(blk);
+    size_t zero = scan(buf, 0, siz, 0);
+    size_t run = 0;
+    size_t i = 0;
+
+    /* The data of a block is written behind the space reserved for its code 
+     * byte and committed once the block is closed. */
+    while (i < siz && avail >= Pending + 2)
+    {
+        if (zero < i)
+            zero = scan(buf, i, siz, 0);
+
+        if (zero == i)
+        {
+            close(out, blk);
+            avail = out.getWriteBlocks(blk);
+            i++;
+            continue;
+        }
+
+        run = min(zero - i, COBS_CODE_MAX - 1 - Pending);
+        run = min(run, avail - Pending - 1);
+        copyTo(blk, Pending + 1, buf + i, run);
+        Pending += run;
+        i += run;
+
+        if (Pending == COBS_CODE_MAX - 1)
+        {
+            close(out, blk);
+            avail = out.getWriteBlocks(blk);
+        }
+    }
+
+    return i;
+}
+
+void CobsEncoder::close(Fifo &out, const FifoBlock blk[2])
+{
+    uint8_t code = Pending + 1;
+
+    copyTo(blk, 0, &code, 1);
+    out.commit(Pending + 1);
+    Pending = 0;
+}
+
+CobsDecoder::CobsDecoder(void) :
+      FrameDecoder()
+    , Code(0)
+    , Zero(false)
+{
+
+}
+
+void CobsDecoder::reset(void)
+{
+    FrameDecoder::reset();
+    Code = 0;
+    Zero = false;
+}
+
+size_t CobsDecoder::decode(Fifo &in, Fifo &out)
+{
+    FifoBlock blk[2];
+    size_t avail = out.getWriteBlocks(blk);
+    const uint8_t *buf = 0;
+    const uint8_t zero = 0;
+    size_t len = 0;
+    size_t res = 0;
+    size_t run = 0;
+    size_t tmp = 0;
+    size_t i = 0;
+
+    while ((len = in.getReadBlock((void **)&buf)) > 0)
+    {
+        i = 0;
+
+        while (i < len)
+        {
+            if (Code == 0)
+            {
+                if (buf[i] == 0)
+                {
+                    i++;
+                    Zero = false;
+                    res = endFrame(out);
+
+                    if (res > 0)
+                    {
+                        in.free(i);
+                        return res;
+                    }
+
+                    continue;
+                }
+
+                if (Zero && store(out, blk, avail, &zero, 1) == 0)
+                {
+                    in.free(i);
+                    return 0;
+                }
+
+                Zero = buf[i] != COBS_CODE_MAX;
+                Code = buf[i] - 1;
+                i++;
+                continue;
+            }
+
+            /* A zero byte within a block ends the frame too early. */
+            run = min((size_t)Code, len - i);
+            run = scan(buf, i, i + run, 0) - i;
+            tmp = store(out, blk, avail, buf + i, run);
+            Code -= tmp;
+            i += tmp;
+
+            if (tmp < run)
+            {
+                in.free(i);
+                return 0;
+            }
+
+            if (Code > 0 && i < len)
+            {
+                error();
+                Code = 0;
+            }
+        }
+
+        in.free(i);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_ATOMIC_HPP_
+#define GENERIC_ATOMIC_HPP_
+
+/*
+ * The atomic access helpers of generic.hpp. They live in their own file so
+ * header only classes can use them without pulling in the other macros of
+ * generic.hpp, like min() or round(), which clash with the standard library.
+ */
+
+#ifndef loadAcquire
+/**
+ * @brief Atomically reads _x with acquire semantics. Used to observe a value 
+ * which has been published by another thread or interrupt by storeRelease().
+ */
+#define loadAcquire(_x)         __atomic_load_n(&(_x), __ATOMIC_ACQUIRE)
+#endif
+
+
+#ifndef storeRelease
+/**
+ * @brief Atomically writes _v to _x with release semantics. All memory writes
+ * done before are visible to whoever observes _v by loadAcquire().
+ */
+#define storeRelease(_x, _v)    __atomic_store_n(&(_x), (_v), __ATOMIC_RELEASE)
+#endif
+
+
+#ifndef loadRelaxed
+/**
+ * @brief Atomically reads _x without any ordering constraints.
+ */
+#define loadRelaxed(_x)         __atomic_load_n(&(_x), __ATOMIC_RELAXED)
+#endif
+
+
+#ifndef storeRelaxed
+/**
+ * @brief Atomically writes _v to _x without any ordering constraints. Used for
+ * values like statistic counters, which are read by other threads.
+ */
+#define storeRelaxed(_x, _v)    __atomic_store_n(&(_x), (_v), __ATOMIC_RELAXED)
+#endif
+
+
+#ifndef compareExchange
+/**
+ * @brief Atomically replaces _x by _v if it equals _e, with acquire and release
+ * semantics. Returns true on success, otherwise _e takes the current value.
+ */
+#define compareExchange(_x, _e, _v)     __atomic_compare_exchange_n(&(_x), \
+                                            &(_e), (_v), false, \
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#endif
+
+
+#ifndef compareExchangeRelaxed
+/**
+ * @brief Like compareExchange() but without any ordering constraints and it 
+ * may fail spuriously, so it has to be used in a loop which retries.
+ */
+#define compareExchangeRelaxed(_x, _e, _v)  __atomic_compare_exchange_n(&(_x), \
+                                            &(_e), (_v), true, \
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#endif
+
+
+#ifndef addRelaxed
+/**
+ * @brief Atomically adds _v to _x without any ordering constraints. Used for
+ * counters which are modified by more than one thread.
+ */
+#define addRelaxed(_x, _v)      __atomic_add_fetch(&(_x), (_v), \
+                                    __ATOMIC_RELAXED)
+#endif
+
+
+#ifndef subRelaxed
+/**
+ * @brief Atomically subtracts _v from _x without any ordering constraints.
+ */
+#define subRelaxed(_x, _v)      __atomic_sub_fetch(&(_x), (_v), \
+                                    __ATOMIC_RELAXED)
+#endif
+
+
+
+#ifndef addRelease
+/**
+ * @brief Atomically adds _v to _x with release semantics.
+ */
+#define addRelease(_x, _v)      __atomic_add_fetch(&(_x), (_v), \
+                                    __ATOMIC_RELEASE)
+#endif
+
+
+#ifndef exchangeRelaxed
+/**
+ * @brief Atomically replaces _x by _v without any ordering constraints. 
+ * Returns the previous value.
+ */
+#define exchangeRelaxed(_x, _v) __atomic_exchange_n(&(_x), (_v), \
+                                    __ATOMIC_RELAXED)
+#endif
+
+
+#ifndef fullFence
+/**
+ * @brief A sequentially consistent fence. Orders a store before a following 
+ * load, e.g. to announce a wait before checking the condition once more.
+ */
+#define fullFence()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#endif /* GENERIC_ATOMIC_HPP_ */
@@ -0,0 +1,178 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_BIPBUFFER_HPP_
+#define GENERIC_BIPBUFFER_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A bip buffer, a fifo which always provides contiguous blocks.
+ * 
+ * Other than Fifo, which splits data at the end of the buffer, the bip buffer
+ * skips the rest of the buffer and wraps around early if a reservation does 
+ * not fit. So every reservation of the producer is contiguous if there is 
+ * enough space at all, and as the consumer gets back exactly the written 
+ * blocks, a record never straddles the end of the buffer either. This works 
+ * on plain memory, no virtual memory tricks are needed.
+ * 
+ * The top bit of both indices tells the lap, it is toggled by every wrap 
+ * around. So a full buffer can be told from an empty one without a spare 
+ * byte, and if the buffer is empty the producer can wrap around at once and 
+ * use all of it. The size must be below the top bit of size_t.
+ * 
+ * Like Fifo the buffer is lock free for one producer and one consumer.
+ * 
+ *  void send(const Packet *pkt)
+ *  {
+ *      uint8_t *p = (uint8_t *)bip.reserve(pkt->len + 1);
+ * 
+ *      if (p)
+ *      {
+ *          p[0] = pkt->len;
+ *          memcpy(&p[1], pkt->data, pkt->len);
+ *          bip.commit(pkt->len + 1);
+ *      }
+ *  }
+ */
+class BipBuffer
+{
+    public:
+
+        BipBuffer();
+
+        BipBuffer(char *buf, size_t siz);
+
+        /**
+         * Used to initialize the buffer.
+         *
+         * @param buf       The data buffer to operate on.
+         * @param siz       The size of the provided buffer.
+         */
+        void init(char *buf, size_t siz);
+
+        /**
+         * To get the size of the buffer during runtime.
+         *
+         * @return The data buffer size in bytes.
+         */
+        size_t getSize(void);
+
+        /**
+         * To get the amount of used data. Bytes skipped at the end of the 
+         * buffer do not count.
+         *
+         * @return The number of used bytes.
+         */
+        size_t getUsed(void);
+
+        /**
+         * Used to reserve a contiguous block for writing. A previous, not yet
+         * committed reservation is discarded.
+         *
+         * @param siz       The size of the block.
+         *
+         * @return          The start of the block or zero if there is no
+         *                  contiguous free block of the requested size.
+         */
+        void *reserve(size_t siz);
+
+        /**
+         * Used to publish data written to the reserved block.
+         *
+         * @param siz       Number of bytes to commit, not more than reserved.
+         */
+        void commit(size_t siz);
+
+        /**
+         * Used to write a block of data at once. Either all data is written or
+         * nothing.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return          The number of written bytes, siz or 0.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  data
+         *
+         * @return          The number of bytes which can be read in a 
+         *                  subsequent way. This block ends on a boundary of 
+         *                  committed blocks.
+         */
+        size_t getReadBlock(void **buf);
+
+        /**
+         * Used to free data read from the block returned by getReadBlock().
+         *
+         * @param siz       Number of bytes to free.
+         */
+        void free(size_t siz);
+
+    private:
+
+        /**
+         * The data array.
+         */
+        char *pData;
+
+        /**
+         * Size of the data array.
+         */
+        size_t Size;
+
+        /**
+         * Start of the current reservation.
+         */
+        size_t ResPos;
+
+        /**
+         * Size of the current reservation.
+         */
+        size_t ResSize;
+
+        /**
+         * Write index and lap, only modified by the producer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Head;
+
+        /**
+         * End of the data before the producer wrapped around, only modified by
+         * the producer. Valid as long as the lap of the head index differs 
+         * from the one of the tail.
+         */
+        size_t Last;
+
+        /**
+         * Read index and lap, only modified by the consumer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Tail;
+};
+
+#endif /* GENERIC_BIPBUFFER_HPP_ */
@@ -0,0 +1,132 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_BLOCKPOOL_HPP_
+#define GENERIC_BLOCKPOOL_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief A lock free pool of fixed size memory blocks.
+ * 
+ * The pool operates on a memory area provided by the caller and splits it into
+ * blocks of equal size. Free blocks are kept in a lock free stack, so blocks 
+ * can be allocated and freed from any thread or interrupt. The stack head is 
+ * tagged with a counter to avoid the ABA problem, hence the number of blocks is
+ * limited to 2^16 - 1 on 32 bit targets.
+ * 
+ *  alignas(void *) static char mem[16 * 256];
+ *  BlockPool pool(mem, sizeof(mem), 256);
+ * 
+ *  void *blk = pool.alloc();
+ *  ...
+ *  pool.free(blk);
+ */
+class BlockPool
+{
+    public:
+
+        BlockPool();
+
+        BlockPool(void *mem, size_t siz, size_t blkSize);
+
+        /**
+         * Used to initialize the pool. Must not be called while the pool is in
+         * use.
+         *
+         * @param mem       The memory area to split into blocks. If it is not
+         *                  aligned to the size of a pointer, the start is 
+         *                  skipped up to the next aligned address.
+         * @param siz       The size of the memory area.
+         * @param blkSize   The size of a single block. It is rounded up to the
+         *                  size of a pointer.
+         */
+        void init(void *mem, size_t siz, size_t blkSize);
+
+        /**
+         * To get the size of the blocks.
+         *
+         * @return The block size in bytes.
+         */
+        size_t getBlockSize(void);
+
+        /**
+         * To get the number of blocks managed by the pool.
+         *
+         * @return The number of blocks.
+         */
+        size_t getCount(void);
+
+        /**
+         * To get the number of free blocks. As other threads might allocate or
+         * free blocks at the same time, the value is just a snapshot.
+         *
+         * @return The number of free blocks.
+         */
+        size_t getFree(void);
+
+        /**
+         * Used to allocate a block.
+         *
+         * @return A pointer to the block or zero if the pool is empty.
+         */
+        void *alloc(void);
+
+        /**
+         * Used to return a block to the pool.
+         *
+         * @param blk       The block, as returned by alloc().
+         */
+        void free(void *blk);
+
+    private:
+
+        /**
+         * The memory area.
+         */
+        char *pMem;
+
+        /**
+         * The size of a block.
+         */
+        size_t BlkSize;
+
+        /**
+         * The number of blocks.
+         */
+        size_t Count;
+
+        /**
+         * The number of free blocks.
+         */
+        size_t FreeCount;
+
+        /**
+         * Head of the free block stack. The lower half holds the index of the
+         * first free block plus one, the upper half a tag which is incremented
+         * on every change.
+         */
+        size_t FreeHead;
+};
+
+#endif /* GENERIC_BLOCKPOOL_HPP_ */
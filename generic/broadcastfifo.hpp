@@ -0,0 +1,218 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_BROADCASTFIFO_HPP_
+#define GENERIC_BROADCASTFIFO_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A fifo with one writer and any number of readers which all see the
+ * same data.
+ * 
+ * Every reader has its own read index, the writer is gated by the slowest 
+ * reader, like in a disruptor. So several consumers can process one stream of 
+ * data without a copy of the data per consumer. The writer caches the free 
+ * space, so the read indices of all readers are only checked if the cached 
+ * space does not suffice.
+ * 
+ * The writer and every reader may run in its own thread. Readers have to be 
+ * attached and detached while the writer is not active.
+ * 
+ *  BroadcastFifo bc(buf, sizeof(buf));
+ *  BroadcastFifo::Reader logger;
+ *  BroadcastFifo::Reader forwarder;
+ * 
+ *  bc.attach(logger);
+ *  bc.attach(forwarder);
+ *  bc.write(data, len);
+ *  logger.read(tmp, sizeof(tmp));
+ */
+class BroadcastFifo
+{
+    public:
+
+        /**
+         * A read index of a BroadcastFifo.
+         */
+        class Reader
+        {
+            public:
+
+                Reader();
+
+                /**
+                 * @brief Destroy the Reader object and detach it.
+                 */
+                ~Reader();
+
+                /**
+                 * To get the amount of data not yet read by this reader.
+                 *
+                 * @return The number of used bytes.
+                 */
+                size_t getUsed(void);
+
+                /**
+                 * Used to copy data from the fifo to the provided buffer.
+                 *
+                 * @param buf       The target buffer to write to.
+                 * @param siz       Number of bytes to read.
+                 *
+                 * @return          The number of bytes read.
+                 */
+                size_t read(void *buf, size_t siz);
+
+                /**
+                 *
+                 * @param buf       A pointer to a pointer to take the address 
+                 *                  of the fifo data
+                 *
+                 * @return          The number of bytes which can be read from 
+                 *                  the fifo in a subsequent way.
+                 */
+                size_t getReadBlock(void **buf);
+
+                /**
+                 * Used to release data for this reader.
+                 *
+                 * @param siz       Number of bytes to free.
+                 */
+                void free(size_t siz);
+
+            private:
+
+                friend class BroadcastFifo;
+
+                Reader(const Reader &);
+                Reader &operator=(const Reader &);
+
+                /**
+                 * The fifo this reader is attached to.
+                 */
+                BroadcastFifo *pFifo;
+
+                /**
+                 * The next reader attached to the same fifo.
+                 */
+                Reader *pNext;
+
+                /**
+                 * Read index, only modified by this reader.
+                 */
+                alignas(FIFO_CACHELINE_SIZE) size_t Tail;
+        };
+
+        BroadcastFifo();
+
+        BroadcastFifo(char *buf, size_t siz);
+
+        /**
+         * Used to initialize the fifo. No reader must be attached.
+         *
+         * @param buf       The fifo buffer to operate on.
+         * @param siz       The size of the provided buffer.
+         */
+        void init(char *buf, size_t siz);
+
+        /**
+         * Used to attach a reader. It will see all data written afterwards.
+         *
+         * @param reader    The reader to attach.
+         */
+        void attach(Reader &reader);
+
+        /**
+         * Used to detach a reader.
+         *
+         * @param reader    The reader to detach.
+         */
+        void detach(Reader &reader);
+
+        /**
+         * To get the size of the fifo during runtime.
+         *
+         * @return The data buffer size in bytes.
+         */
+        size_t getSize(void);
+
+        /**
+         * To get the amount of space not used by any reader.
+         *
+         * @return the number of free bytes.
+         */
+        size_t getFree(void);
+
+        /**
+         * Used to write a given number of bytes to the fifo.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         * Used to put just one byte to the fifo.
+         *
+         * @param c         The byte to write to the fifo.
+         *
+         * @return The number of bytes written (0/1).
+         */
+        size_t put(const void *c);
+
+    private:
+
+        BroadcastFifo(const BroadcastFifo &);
+        BroadcastFifo &operator=(const BroadcastFifo &);
+
+        /**
+         * The data array.
+         */
+        char *pData;
+
+        /**
+         * Size of the data array.
+         */
+        size_t Size;
+
+        /**
+         * List of attached readers.
+         */
+        Reader *pReaders;
+
+        /**
+         * Free space as seen by the last check of all readers.
+         */
+        size_t CachedFree;
+
+        /**
+         * Write index, only modified by the writer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Head;
+};
+
+#endif /* GENERIC_BROADCASTFIFO_HPP_ */
@@ -0,0 +1,211 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_CHAINFIFO_HPP_
+#define GENERIC_CHAINFIFO_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+#include "generic/blockpool.hpp"
+
+/**
+ * @brief A growable byte fifo built from a chain of pool blocks.
+ * 
+ * Other than Fifo, which is fixed to the size of its buffer, this fifo takes
+ * blocks from a BlockPool as data is written and returns them as soon as they
+ * have been drained. So the memory used follows the actual backlog and many 
+ * fifos can share one pool instead of being sized for the worst case burst.
+ * 
+ * Like Fifo it is lock free for one producer and one consumer. The producer 
+ * (write) only modifies the newest segment, its fill level and the link to a
+ * new segment, the consumer (read, getReadBlock, free, clear) only modifies 
+ * the oldest segment and the read position. Fill levels and links are 
+ * published with release and observed with acquire semantics. As the producer
+ * might still write to the newest segment, it is kept even if it has been 
+ * drained, so a fifo which has been used holds at least one block until it is
+ * destroyed.
+ * 
+ *  alignas(void *) static char mem[64 * 128];
+ *  BlockPool pool(mem, sizeof(mem), 128);
+ *  ChainFifo rx(pool);
+ *  ChainFifo tx(pool);
+ */
+class ChainFifo
+{
+    public:
+
+        /**
+         * @brief Construct a new ChainFifo object.
+         * 
+         * @param pool      The pool to take the blocks from. The block size 
+         *                  must be larger than a pointer and a size_t.
+         */
+        ChainFifo(BlockPool &pool);
+
+        /**
+         * @brief Destroy the ChainFifo object and return all blocks. Must not
+         * race with the producer or the consumer.
+         */
+        ~ChainFifo();
+
+        /**
+         * To get the amount of used fifo data.
+         *
+         * @return The number of used bytes.
+         */
+        size_t getUsed(void);
+
+        /**
+         * Used to write a given number of bytes to the fifo. Less bytes are 
+         * written if the pool runs out of blocks.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         * Used to copy data from the fifo to the provided buffer.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       Number of bytes to read. Hence that less bytes then
+         *                  requested will be read from the fifo if less bytes
+         *                  are available.
+         *
+         * @return          The number of bytes read.
+         */
+        size_t read(void *buf, size_t siz);
+
+        /**
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  fifo data
+         *
+         * @return          The number of bytes which can be read from the fifo
+         *                  in a subsequent way, which is limited to the rest of
+         *                  the oldest block.
+         */
+        size_t getReadBlock(void **buf);
+
+        /**
+         * Used to free space in the fifo. The function will free not more bytes
+         * then provided, but maybe less if less bytes are used. Drained blocks
+         * are returned to the pool.
+         *
+         * @param siz       Number of bytes to free.
+         */
+        void free(size_t siz);
+
+        /**
+         * Used by the consumer to drop all data.
+         */
+        void clear(void);
+
+    private:
+
+        ChainFifo(const ChainFifo &);
+        ChainFifo &operator=(const ChainFifo &);
+
+        /**
+         * The header at the start of every block.
+         */
+        struct Segment
+        {
+            /**
+             * The next newer segment, zero for the newest one. Set by the 
+             * producer.
+             */
+            Segment *pNext;
+
+            /**
+             * Number of data bytes written to the segment by the producer.
+             */
+            size_t Fill;
+        };
+
+        /**
+         * Used to get the data area of a segment.
+         */
+        static char *getData(Segment *seg);
+
+        /**
+         * Used by the consumer to get the oldest segment. Drained segments are
+         * returned to the pool as soon as the producer has moved on to a newer
+         * one.
+         *
+         * @return          The oldest segment, zero if nothing has been 
+         *                  written yet.
+         */
+        Segment *getFirst(void);
+
+        /**
+         * Used to read or to just drop data.
+         *
+         * @param buf       The target buffer or zero to drop the data.
+         * @param siz       Number of bytes.
+         *
+         * @return          The number of bytes consumed.
+         */
+        size_t consume(void *buf, size_t siz);
+
+        /**
+         * The pool to take the blocks from.
+         */
+        BlockPool *pPool;
+
+        /**
+         * The number of data bytes per segment.
+         */
+        size_t SegSize;
+
+        /**
+         * The newest segment, only used by the producer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) Segment *pLast;
+
+        /**
+         * Total number of bytes written, only modified by the producer.
+         */
+        size_t Written;
+
+        /**
+         * The oldest segment, only modified by the consumer once the producer
+         * has set it to the first segment.
+         */
+        alignas(FIFO_CACHELINE_SIZE) Segment *pFirst;
+
+        /**
+         * Read position within the oldest segment, only used by the consumer.
+         */
+        size_t ReadPos;
+
+        /**
+         * Total number of bytes consumed, only modified by the consumer.
+         */
+        size_t Consumed;
+};
+
+#endif /* GENERIC_CHAINFIFO_HPP_ */
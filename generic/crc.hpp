@@ -0,0 +1,472 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_CRC_HPP_
+#define GENERIC_CRC_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/crc8.hpp"
+
+/**
+ * @brief Returns a mask of the lower width bits.
+ */
+constexpr uint64_t crcMask(unsigned width)
+{
+    return width >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << width) - 1;
+}
+
+/**
+ * @brief Reverses the order of the lower width bits of val.
+ */
+constexpr uint64_t crcReflect(uint64_t val, unsigned width)
+{
+    return width == 0 ? 0 : 
+        ((val & 1) << (width - 1)) | crcReflect(val >> 1, width - 1);
+}
+
+/**
+ * @brief Processes bits bits of the crc register val bitwise.
+ * 
+ * @param val       The crc register.
+ * @param poly      The polynom, reflected if refIn is true.
+ * @param width     The width of the crc in bits.
+ * @param refIn     True if the register is shifted to the right.
+ * @param bits      Number of bits to process.
+ * @return uint64_t The new crc register.
+ */
+constexpr uint64_t crcShift(uint64_t val, uint64_t poly, unsigned width, 
+    bool refIn, int bits)
+{
+    return bits == 0 ? val : crcShift(refIn ? 
+        ((val & 1) ? (val >> 1) ^ poly : val >> 1) :
+        (((val >> (width - 1)) & 1) ? (val << 1) ^ poly : val << 1) 
+            & crcMask(width), 
+        poly, width, refIn, bits - 1);
+}
+
+/**
+ * @brief Calculates the table entry for the given byte at compile time.
+ */
+constexpr uint64_t crcTableEntry(uint64_t idx, uint64_t poly, unsigned width,
+    bool refIn)
+{
+    return refIn ? crcShift(idx, crcReflect(poly, width), width, true, 8) :
+        crcShift(idx << (width - 8), poly, width, false, 8);
+}
+
+/**
+ * @brief Selects the smallest unsigned type to hold a crc of the given width.
+ */
+template <unsigned Width> struct crcValue;
+template <> struct crcValue<8>  { typedef uint8_t type; };
+template <> struct crcValue<16> { typedef uint16_t type; };
+template <> struct crcValue<32> { typedef uint32_t type; };
+template <> struct crcValue<64> { typedef uint64_t type; };
+
+#define CRC_TAB_1(i)    (value_t)crcTableEntry((i), Poly, Width, RefIn)
+#define CRC_TAB_4(i)    CRC_TAB_1(i), CRC_TAB_1(i + 1), \
+                        CRC_TAB_1(i + 2), CRC_TAB_1(i + 3)
+#define CRC_TAB_16(i)   CRC_TAB_4(i), CRC_TAB_4(i + 4), \
+                        CRC_TAB_4(i + 8), CRC_TAB_4(i + 12)
+#define CRC_TAB_64(i)   CRC_TAB_16(i), CRC_TAB_16(i + 16), \
+                        CRC_TAB_16(i + 32), CRC_TAB_16(i + 48)
+#define CRC_TAB_256     CRC_TAB_64(0), CRC_TAB_64(64), \
+                        CRC_TAB_64(128), CRC_TAB_64(192)
+
+/**
+ * @brief A table driven crc of 8, 16, 32 or 64 bit following the Rocksoft 
+ * model, see "A painless guide to crc error detection algorithms" by Ross N. 
+ * Williams.
+ * 
+ * @param Width     The width of the crc in bits.
+ * @param Poly      The polynom in normal notation, without the top bit.
+ * @param Init      The initial crc value, not reflected.
+ * @param RefIn     True if the bits of each input byte are processed LSB first.
+ * @param RefOut    True if the final crc value is reflected.
+ * @param XorOut    The value to xor the final crc value with.
+ * 
+ * The lookup table is generated at compile time. For the crc of a single 
+ * buffer use compute(), to process data in chunks use an instance:
+ * 
+ *  crc32IsoHdlc crc;
+ *  
+ *  crc.calc(&hdr, sizeof(hdr));
+ *  crc.calc(pPayload, len);
+ *  printf("Test CRC: 0x%08x\n", (uint32_t)crc);
+ * 
+ * The presets below cover well known crcs. The results of crc8 equal 
+ * crcModel<8, poly, val, false, false, 0>.
+ */
+template <unsigned Width, uint64_t Poly, uint64_t Init, bool RefIn, 
+    bool RefOut, uint64_t XorOut> class crcModel
+{
+    public:
+
+        /**
+         * @brief The type of the crc value.
+         */
+        typedef typename crcValue<Width>::type value_t;
+
+        /**
+         * @brief The lookup table.
+         */
+        static constexpr value_t Table[256] = { CRC_TAB_256 };
+
+        /**
+         * @brief Construct a new crcModel object, initialized to Init.
+         */
+        crcModel() :
+              reg(RefIn ? (value_t)crcReflect(Init, Width) : (value_t)Init)
+        {
+
+        }
+
+        /**
+         * @brief Used to restart the calculation with the initial value.
+         */
+        void reset(void)
+        {
+            reg = RefIn ? (value_t)crcReflect(Init, Width) : (value_t)Init;
+        }
+
+        /**
+         * @brief Used to update the crc value by a single byte.
+         * 
+         * @param data      The data byte.
+         * @return value_t  The new crc value.
+         */
+        value_t calc(uint8_t data)
+        {
+            reg = update(reg, data);
+
+            return *this;
+        }
+
+        /**
+         * @brief Used to update the crc value by processing the provided data.
+         * 
+         * @param pData     Pointer to the data to process.
+         * @param siz       Number of bytes to process.
+         * @return value_t  The new crc value.
+         */
+        value_t calc(const void *pData, size_t siz)
+        {
+            const uint8_t *tmp = (const uint8_t *)pData;
+            value_t r = reg;
+
+            while (siz > 0)
+            {
+                r = update(r, *tmp++);
+                siz--;
+            }
+
+            reg = r;
+
+            return *this;
+        }
+
+        /**
+         * @brief Used to calculate the crc of a buffer in one call.
+         * 
+         * @param pData     Pointer to the data to process.
+         * @param siz       Number of bytes to process.
+         * @return value_t  The crc value.
+         */
+        static value_t compute(const void *pData, size_t siz)
+        {
+            crcModel tmp;
+
+            return tmp.calc(pData, siz);
+        }
+
+        /**
+         * @brief Used to calculate the crc of constant data at compile time.
+         * The result equals compute(). The recursion depth grows with the 
+         * length, which limits it to a few hundred bytes with the default 
+         * compiler settings.
+         * 
+         * @param str       The data to process.
+         * @param len       Number of bytes to process.
+         * @return value_t  The crc value.
+         */
+        static constexpr value_t of(const char *str, size_t len)
+        {
+            return finish(ofReg(str, len, 
+                RefIn ? (value_t)crcReflect(Init, Width) : (value_t)Init));
+        }
+
+        /**
+         * @brief Same as above for a string literal, without the terminating 
+         * zero.
+         */
+        template <size_t N> static constexpr value_t of(const char (&str)[N])
+        {
+            return of(str, N - 1);
+        }
+
+        /**
+         * @brief Used to get the crc of two concatenated buffers A and B from 
+         * the crcs of both buffers, without touching the data again. The cost
+         * grows with log(lenB) only.
+         * 
+         * @param crcA      The crc of buffer A.
+         * @param crcB      The crc of buffer B.
+         * @param lenB      The length of buffer B in bytes.
+         * @return value_t  The crc of A followed by B.
+         */
+        static value_t combine(value_t crcA, value_t crcB, uint64_t lenB)
+        {
+            uint64_t a = toNormal(crcA ^ (value_t)XorOut, RefOut);
+            uint64_t b = toNormal(crcB ^ (value_t)XorOut, RefOut);
+
+            /* The register of B would have been A instead of Init, which 
+             * differs by A ^ Init shifted through lenB zero bytes. */
+            a = mulMod(a ^ Init, powMod(lenB));
+
+            return (value_t)(toNormal(a ^ b, RefOut) ^ XorOut);
+        }
+
+        /**
+         * @brief Cast operator used for reading the crc.
+         * 
+         * @return value_t  The current crc value.
+         */
+        operator value_t()
+        {
+            return finish(reg);
+        }
+
+    private:
+
+        static_assert(Width == 8 || Width == 16 || Width == 32 || Width == 64,
+            "crcModel supports a width of 8, 16, 32 or 64 bit");
+
+        /**
+         * @brief Processes one byte.
+         */
+        static constexpr value_t update(value_t r, uint8_t data)
+        {
+            return RefIn ? 
+                (value_t)(Table[(r ^ data) & 0xff] ^ (value_t)(r >> 8)) :
+                (value_t)(Table[((r >> (Width - 8)) ^ data) & 0xff] ^ 
+                    (value_t)((uint64_t)r << 8));
+        }
+
+        /**
+         * @brief Processes len bytes at compile time.
+         */
+        static constexpr value_t ofReg(const char *str, size_t len, value_t r)
+        {
+            return len == 0 ? r : 
+                ofReg(str + 1, len - 1, update(r, (uint8_t)str[0]));
+        }
+
+        /**
+         * @brief Converts the crc register to the crc value.
+         */
+        static constexpr value_t finish(value_t r)
+        {
+            return (value_t)((RefIn != RefOut ? 
+                crcReflect(r, Width) : r) ^ XorOut);
+        }
+
+        /**
+         * @brief Converts between a crc value and its normal bit order.
+         */
+        static uint64_t toNormal(uint64_t val, bool reflected)
+        {
+            return reflected ? crcReflect(val, Width) : val;
+        }
+
+        /**
+         * @brief Multiplies a and b modulo the polynom.
+         */
+        static uint64_t mulMod(uint64_t a, uint64_t b)
+        {
+            uint64_t res = 0;
+
+            for (int i = Width - 1; i >= 0; i--)
+            {
+                res = crcShift(res, Poly, Width, false, 1);
+
+                if ((b >> i) & 1)
+                    res ^= a;
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief Calculates x^(8 * n) modulo the polynom.
+         */
+        static uint64_t powMod(uint64_t n)
+        {
+            uint64_t res = 1;
+            uint64_t sq = crcShift(1, Poly, Width, false, 8);
+
+            while (n > 0)
+            {
+                if (n & 1)
+                    res = mulMod(res, sq);
+
+                sq = mulMod(sq, sq);
+                n >>= 1;
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief The crc register, reflected if RefIn is true.
+         */
+        value_t reg;
+};
+
+template <unsigned Width, uint64_t Poly, uint64_t Init, bool RefIn, 
+    bool RefOut, uint64_t XorOut> 
+constexpr typename crcModel<Width, Poly, Init, RefIn, RefOut, XorOut>::value_t 
+    crcModel<Width, Poly, Init, RefIn, RefOut, XorOut>::Table[256];
+
+#undef CRC_TAB_1
+#undef CRC_TAB_4
+#undef CRC_TAB_16
+#undef CRC_TAB_64
+#undef CRC_TAB_256
+
+/**
+ * @brief Well known crcs, named as in the catalogue of parametrised crc 
+ * algorithms by Greg Cook. The check value is the crc of "123456789".
+ */
+
+/* CRC-8/SMBUS, check 0xF4 */
+typedef crcModel<8, CRC8_POLY_ITU, 0x00, false, false, 0x00> crc8Smbus;
+
+/* CRC-8/I-432-1, check 0xA1 */
+typedef crcModel<8, CRC8_POLY_ITU, 0x00, false, false, 0x55> crc8I4321;
+
+/* CRC-8/ROHC, check 0xD0 */
+typedef crcModel<8, CRC8_POLY_ROHC, 0xFF, true, true, 0x00> crc8Rohc;
+
+/* CRC-8/MAXIM-DOW, check 0xA1 */
+typedef crcModel<8, CRC8_POLY_MAXIM, 0x00, true, true, 0x00> crc8MaximDow;
+
+/* CRC-8/DARC, check 0x15 */
+typedef crcModel<8, CRC8_POLY_DARC, 0x00, true, true, 0x00> crc8Darc;
+
+/* CRC-8/CDMA2000, check 0xDA */
+typedef crcModel<8, CRC8_POLY_CDMA2000, 0xFF, false, false, 0x00> crc8Cdma2000;
+
+/* CRC-8/WCDMA, check 0x25 */
+typedef crcModel<8, CRC8_POLY_WCDMA, 0x00, true, true, 0x00> crc8Wcdma;
+
+/* CRC-8/DVB-S2, check 0xBC */
+typedef crcModel<8, CRC8_POLY_DVB_S2, 0x00, false, false, 0x00> crc8DvbS2;
+
+/* CRC-8/TECH-3250 (EBU), check 0x97 */
+typedef crcModel<8, CRC8_POLY_EBU, 0xFF, true, true, 0x00> crc8Tech3250;
+
+/* CRC-8/I-CODE, check 0x7E */
+typedef crcModel<8, CRC8_POLY_I_CODE, 0xFD, false, false, 0x00> crc8ICode;
+
+/* CRC-8/SAE-J1850, check 0x4B */
+typedef crcModel<8, 0x1D, 0xFF, false, false, 0xFF> crc8SaeJ1850;
+
+/* CRC-8/AUTOSAR, check 0xDF */
+typedef crcModel<8, 0x2F, 0xFF, false, false, 0xFF> crc8Autosar;
+
+/* CRC-16/ARC, check 0xBB3D */
+typedef crcModel<16, 0x8005, 0x0000, true, true, 0x0000> crc16Arc;
+
+/* CRC-16/MODBUS, check 0x4B37 */
+typedef crcModel<16, 0x8005, 0xFFFF, true, true, 0x0000> crc16Modbus;
+
+/* CRC-16/IBM-3740 (CCITT-FALSE), check 0x29B1 */
+typedef crcModel<16, 0x1021, 0xFFFF, false, false, 0x0000> crc16Ibm3740;
+
+/* CRC-16/XMODEM, check 0x31C3 */
+typedef crcModel<16, 0x1021, 0x0000, false, false, 0x0000> crc16Xmodem;
+
+/* CRC-16/KERMIT, check 0x2189 */
+typedef crcModel<16, 0x1021, 0x0000, true, true, 0x0000> crc16Kermit;
+
+/* CRC-16/IBM-SDLC (X-25), check 0x906E */
+typedef crcModel<16, 0x1021, 0xFFFF, true, true, 0xFFFF> crc16IbmSdlc;
+
+/* CRC-32/ISO-HDLC, check 0xCBF43926 */
+typedef crcModel<32, 0x04C11DB7, 0xFFFFFFFF,
+    true, true, 0xFFFFFFFF> crc32IsoHdlc;
+
+/* CRC-32/ISCSI (CRC-32C), check 0xE3069283 */
+typedef crcModel<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF> crc32Iscsi;
+
+/* CRC-32/BZIP2, check 0xFC891918 */
+typedef crcModel<32, 0x04C11DB7, 0xFFFFFFFF,
+    false, false, 0xFFFFFFFF> crc32Bzip2;
+
+/* CRC-32/MPEG-2, check 0x0376E6E7 */
+typedef crcModel<32, 0x04C11DB7, 0xFFFFFFFF,
+    false, false, 0x00000000> crc32Mpeg2;
+
+/* CRC-64/ECMA-182, check 0x6C40DF5F0B497347 */
+typedef crcModel<64, 0x42F0E1EBA9EA3693, 0x0000000000000000, false, false, 
+    0x0000000000000000> crc64Ecma182;
+
+/* CRC-64/XZ, check 0x995DC9BBDF1939FA */
+typedef crcModel<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true, 
+    0xFFFFFFFFFFFFFFFF> crc64Xz;
+
+/**
+ * @brief Define CRC_CHECK_PRESETS to verify the presets against their check 
+ * values at compile time. It is not done by default as it needs to generate 
+ * all tables, which slows down every build including this file.
+ */
+#ifdef CRC_CHECK_PRESETS
+static_assert(crc8Smbus::of("123456789") == 0xF4, "crc8Smbus");
+static_assert(crc8I4321::of("123456789") == 0xA1, "crc8I4321");
+static_assert(crc8Rohc::of("123456789") == 0xD0, "crc8Rohc");
+static_assert(crc8MaximDow::of("123456789") == 0xA1, "crc8MaximDow");
+static_assert(crc8Darc::of("123456789") == 0x15, "crc8Darc");
+static_assert(crc8Cdma2000::of("123456789") == 0xDA, "crc8Cdma2000");
+static_assert(crc8Wcdma::of("123456789") == 0x25, "crc8Wcdma");
+static_assert(crc8DvbS2::of("123456789") == 0xBC, "crc8DvbS2");
+static_assert(crc8Tech3250::of("123456789") == 0x97, "crc8Tech3250");
+static_assert(crc8ICode::of("123456789") == 0x7E, "crc8ICode");
+static_assert(crc8SaeJ1850::of("123456789") == 0x4B, "crc8SaeJ1850");
+static_assert(crc8Autosar::of("123456789") == 0xDF, "crc8Autosar");
+static_assert(crc16Arc::of("123456789") == 0xBB3D, "crc16Arc");
+static_assert(crc16Modbus::of("123456789") == 0x4B37, "crc16Modbus");
+static_assert(crc16Ibm3740::of("123456789") == 0x29B1, "crc16Ibm3740");
+static_assert(crc16Xmodem::of("123456789") == 0x31C3, "crc16Xmodem");
+static_assert(crc16Kermit::of("123456789") == 0x2189, "crc16Kermit");
+static_assert(crc16IbmSdlc::of("123456789") == 0x906E, "crc16IbmSdlc");
+static_assert(crc32IsoHdlc::of("123456789") == 0xCBF43926, "crc32IsoHdlc");
+static_assert(crc32Iscsi::of("123456789") == 0xE3069283, "crc32Iscsi");
+static_assert(crc32Bzip2::of("123456789") == 0xFC891918, "crc32Bzip2");
+static_assert(crc32Mpeg2::of("123456789") == 0x0376E6E7, "crc32Mpeg2");
+static_assert(crc64Ecma182::of("123456789") == 0x6C40DF5F0B497347ull,
+    "crc64Ecma182");
+static_assert(crc64Xz::of("123456789") == 0x995DC9BBDF1939FAull, "crc64Xz");
+#endif
+
+#endif /* GENERIC_CRC_HPP_ */
@@ -44,6 +44,22 @@
 #define CRC8_POLY_ROHC                  0x07
 #define CRC8_POLY_WCDMA                 0x9B
 
+/**
+ * @brief Describes one buffer of a batch of buffers to calculate the crc of.
+ */
+struct crcBlock
+{
+    /**
+     * @brief Pointer to the data.
+     */
+    const void *pData;
+
+    /**
+     * @brief Number of bytes.
+     */
+    size_t Size;
+};
+
 /**
  * @brief A Class to calculate crc8 values.
  * 
@@ -114,6 +130,60 @@ class crc8
          */
         uint8_t calc(void* pData, size_t siz);
 
+        /**
+         * @brief Used to get the crc of two concatenated buffers A and B from
+         *        the crcs of both buffers, without touching the data again. 
+         *        So buffers can be processed independently and combined 
+         *        afterwards, like crcModel::combine().
+         * 
+         * @param crcA      The crc of buffer A.
+         * @param crcB      The crc of buffer B.
+         * @param lenB      The length of buffer B in bytes.
+         * @param init      The value both crcs have been started with.
+         * @param poly      Optional parameter used to set the polynom.
+         *                  Defaults to CRC8_POLY_DEFAULT
+         * @return uint8_t  The crc of A followed by B.
+         */
+        static uint8_t combine(uint8_t crcA, uint8_t crcB, size_t lenB, 
+            uint8_t init = 0, uint8_t poly = CRC8_POLY_DEFAULT);
+
+        /**
+         * @brief Used to calculate the crc of constant data at compile time,
+         *        like a string used as message id:
+         * 
+         *        switch (id)
+         *        {
+         *            case crc8::of("temp_sensor"):
+         *                ...
+         *        }
+         * 
+         *        The result equals calc(...) on a new object with the same 
+         *        initial value and polynom. Can be used at runtime as well.
+         * 
+         * @param str       The data to process.
+         * @param len       Number of bytes to process.
+         * @param val       Optional parameter used to initialize the crc value.
+         *                  Defaults to zero.
+         * @param poly      Optional parameter used to set the polynom.
+         *                  Defaults to CRC8_POLY_DEFAULT
+         * @return uint8_t  The crc value.
+         */
+        static constexpr uint8_t of(const char *str, size_t len, 
+            uint8_t val = 0, uint8_t poly = CRC8_POLY_DEFAULT)
+        {
+            return len == 0 ? val : of(str + 1, len - 1, 
+                shift(val ^ (uint8_t)str[0], poly, 8), poly);
+        }
+
+        /**
+         * @brief Same as above for a string literal, without the terminating
+         *        zero.
+         */
+        template <size_t N> static constexpr uint8_t of(const char (&str)[N])
+        {
+            return of(str, N - 1);
+        }
+
         /**
          * @brief Cast to uint8_t operator used for reading the crc.
          * 
@@ -123,6 +193,16 @@ class crc8
 
     private:
 
+        /**
+         * @brief Processes bits bits of the crc value at compile time.
+         */
+        static constexpr uint8_t shift(uint8_t val, uint8_t poly, int bits)
+        {
+            return bits == 0 ? val : shift((val & 0x80) ? 
+                (uint8_t)((val << 1) ^ poly) : (uint8_t)(val << 1), 
+                poly, bits - 1);
+        }
+
         /**
          * @brief The crc value stored in this calss.
          */
@@ -134,4 +214,13 @@ class crc8
         uint8_t polynom;
 };
 
+/**
+ * @brief User defined literal for the crc8 of a string at compile time, using
+ * the defaults of crc8. "temp_sensor"_crc8 equals crc8::of("temp_sensor").
+ */
+constexpr uint8_t operator "" _crc8(const char *str, size_t len)
+{
+    return crc8::of(str, len);
+}
+
 #endif /* CRC8_HPP_ */
\ No newline at end of file
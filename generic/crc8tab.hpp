@@ -0,0 +1,357 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_CRC8TAB_HPP_
+#define GENERIC_CRC8TAB_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/crc8.hpp"
+
+/**
+ * @brief Calculates a table entry at compile time.
+ * 
+ * @param val       The table index, shifted by the recursion.
+ * @param poly      The polynom.
+ * @param bits      Number of bits to process. Use 8 for the byte table and 
+ *                  8 * (k + 1) for the table of slice k, which equals the crc 
+ *                  of the byte followed by k zero bytes.
+ * @return uint8_t  The crc of the given byte.
+ */
+constexpr uint8_t crc8tabEntry(uint8_t val, uint8_t poly, int bits = 8)
+{
+    return bits == 0 ? val : crc8tabEntry((val & 0x80) ? 
+        (uint8_t)((val << 1) ^ poly) : (uint8_t)(val << 1), poly, bits - 1);
+}
+
+#define CRC8TAB_1(i, k)     crc8tabEntry((i), Poly, 8 * ((k) + 1))
+#define CRC8TAB_4(i, k)     CRC8TAB_1(i, k), CRC8TAB_1(i + 1, k), \
+                            CRC8TAB_1(i + 2, k), CRC8TAB_1(i + 3, k)
+#define CRC8TAB_16(i, k)    CRC8TAB_4(i, k), CRC8TAB_4(i + 4, k), \
+                            CRC8TAB_4(i + 8, k), CRC8TAB_4(i + 12, k)
+#define CRC8TAB_64(i, k)    CRC8TAB_16(i, k), CRC8TAB_16(i + 16, k), \
+                            CRC8TAB_16(i + 32, k), CRC8TAB_16(i + 48, k)
+#define CRC8TAB_256(k)      { CRC8TAB_64(0, k), CRC8TAB_64(64, k), \
+                            CRC8TAB_64(128, k), CRC8TAB_64(192, k) }
+#define CRC8TAB_4X(k)       CRC8TAB_256(k), CRC8TAB_256(k + 1), \
+                            CRC8TAB_256(k + 2), CRC8TAB_256(k + 3)
+
+/**
+ * @brief Holds the lookup tables of crc8tab, one per slice. Only defined for 
+ * 1, 4, 8 and 16 slices.
+ */
+template <uint8_t Poly, unsigned Slices> struct crc8tabData;
+
+template <uint8_t Poly> struct crc8tabData<Poly, 1>
+{
+    static constexpr uint8_t Table[1][256] = { CRC8TAB_256(0) };
+};
+
+template <uint8_t Poly> struct crc8tabData<Poly, 4>
+{
+    static constexpr uint8_t Table[4][256] = { CRC8TAB_4X(0) };
+};
+
+template <uint8_t Poly> struct crc8tabData<Poly, 8>
+{
+    static constexpr uint8_t Table[8][256] = { CRC8TAB_4X(0), CRC8TAB_4X(4) };
+};
+
+template <uint8_t Poly> struct crc8tabData<Poly, 16>
+{
+    static constexpr uint8_t Table[16][256] = { CRC8TAB_4X(0), CRC8TAB_4X(4), 
+        CRC8TAB_4X(8), CRC8TAB_4X(12) };
+};
+
+template <uint8_t Poly> constexpr uint8_t crc8tabData<Poly, 1>::Table[1][256];
+template <uint8_t Poly> constexpr uint8_t crc8tabData<Poly, 4>::Table[4][256];
+template <uint8_t Poly> constexpr uint8_t crc8tabData<Poly, 8>::Table[8][256];
+template <uint8_t Poly> constexpr uint8_t crc8tabData<Poly, 16>::Table[16][256];
+
+/**
+ * @brief A table driven crc8 with the polynom as template parameter.
+ * 
+ * Provides the same interface and the same results as crc8, but the 256 byte 
+ * lookup table is generated by the compiler. So it is placed in read only 
+ * memory, needs no initialization at startup and there is one table per used 
+ * polynom only. Each byte takes one table lookup instead of the eight 
+ * iterations of the bitwise calculation.
+ * 
+ *  crc8tab<CRC8_POLY_MAXIM> crc;
+ *  
+ *  crc.calc(&data[0], len);
+ *  printf("Test CRC: 0x%02x\n", (uint8_t)crc);
+ * 
+ * For bulk data the number of slices can be set to 4, 8 or 16. Then that 
+ * many bytes are processed at once by independent lookups in one table per 
+ * slice, so only one lookup per block depends on the previous crc value. This 
+ * costs 256 bytes of read only memory per slice.
+ * 
+ *  crc8tab<CRC8_POLY_DEFAULT, 8> crc;
+ * 
+ * Use crc8 if the polynom is not known at compile time or if the memory for 
+ * the table can not be spared.
+ */
+template <uint8_t Poly = CRC8_POLY_DEFAULT, unsigned Slices = 1> class crc8tab
+{
+    public:
+
+        /**
+         * @brief The type of the crc value, as for crcModel.
+         */
+        typedef uint8_t value_t;
+
+        /**
+         * @brief The lookup tables, where Table[0] is the byte table.
+         */
+        static constexpr const uint8_t (&Table)[Slices][256] = 
+            crc8tabData<Poly, Slices>::Table;
+
+        /**
+         * @brief Construct a new crc8tab object
+         * 
+         * @param val       Optional parameter used to initialize the crc value.
+         *                  Defaults to zero.
+         */
+        crc8tab(uint8_t val = 0) :
+              value(val)
+        {
+
+        }
+
+        /**
+         * @brief Used to update the crc value by a single byte.
+         * 
+         * @param data      The data byte.
+         * @return uint8_t  The new crc value.
+         */
+        uint8_t calc(uint8_t data)
+        {
+            value = Table[0][value ^ data];
+
+            return value;
+        }
+
+        /**
+         * @brief Used to update the crc value by processing the provided data.
+         * 
+         * @param pData     Pointer to the data to process.
+         * @param siz       Number of bytes to process.
+         * @return uint8_t  The new crc value.
+         */
+        uint8_t calc(const void *pData, size_t siz)
+        {
+            const uint8_t *tmp = (const uint8_t *)pData;
+            uint8_t crc = value;
+
+            while (Slices > 1 && siz >= Slices)
+            {
+                uint8_t next = 0;
+
+                /* Groups of four lookups, so the compiler does not have to 
+                 * unroll the loop to get independent loads. */
+                for (unsigned i = 0; i < Slices; i += 4)
+                {
+                    next ^= Table[Slices - 1 - i][tmp[i] ^ crc]
+                        ^ Table[Slices - 2 - i][tmp[i + 1]]
+                        ^ Table[Slices - 3 - i][tmp[i + 2]]
+                        ^ Table[Slices - 4 - i][tmp[i + 3]];
+                    crc = 0;
+                }
+
+                crc = next;
+                tmp += Slices;
+                siz -= Slices;
+            }
+
+            while (siz > 0)
+            {
+                crc = Table[0][crc ^ *tmp++];
+                siz--;
+            }
+
+            value = crc;
+
+            return value;
+        }
+
+        /**
+         * @brief Used to calculate the crcs of many small buffers, like one 
+         * per received frame.
+         * 
+         * Four buffers are processed interleaved, so the lookups of four 
+         * independent crcs are in flight at once instead of one chain of 
+         * dependent lookups. A lane which finished its buffer takes the next 
+         * one of the batch.
+         * 
+         * @param pBlk      The buffers.
+         * @param pCrc      Takes the crc of each buffer.
+         * @param cnt       The number of buffers.
+         * @param init      The initial crc value of each buffer.
+         */
+        static void calcBatch(const crcBlock *pBlk, uint8_t *pCrc, size_t cnt,
+            uint8_t init = 0)
+        {
+            const uint8_t *p[4] = { 0, 0, 0, 0 };
+            size_t left[4] = { 0, 0, 0, 0 };
+            size_t idx[4] = { 0, 0, 0, 0 };
+            uint8_t c[4] = { init, init, init, init };
+            bool busy[4] = { false, false, false, false };
+            size_t next = 0;
+
+            while (true)
+            {
+                size_t len = (size_t)-1;
+                int active = -1;
+
+                for (int k = 0; k < 4; k++)
+                {
+                    while (!busy[k] && next < cnt)
+                    {
+                        if (pBlk[next].Size == 0)
+                        {
+                            pCrc[next++] = init;
+                            continue;
+                        }
+
+                        p[k] = (const uint8_t *)pBlk[next].pData;
+                        left[k] = pBlk[next].Size;
+                        idx[k] = next++;
+                        c[k] = init;
+                        busy[k] = true;
+                    }
+
+                    if (busy[k])
+                    {
+                        active = k;
+
+                        if (left[k] < len)
+                            len = left[k];
+                    }
+                }
+
+                if (active < 0)
+                    break;
+
+                /* Idle lanes read along with an active one, their results are
+                 * never used. */
+                for (int k = 0; k < 4; k++)
+                {
+                    if (!busy[k])
+                        p[k] = p[active];
+                }
+
+                const uint8_t *p0 = p[0], *p1 = p[1], *p2 = p[2], *p3 = p[3];
+                uint8_t c0 = c[0], c1 = c[1], c2 = c[2], c3 = c[3];
+
+                for (size_t i = 0; i < len; i++)
+                {
+                    c0 = Table[0][c0 ^ p0[i]];
+                    c1 = Table[0][c1 ^ p1[i]];
+                    c2 = Table[0][c2 ^ p2[i]];
+                    c3 = Table[0][c3 ^ p3[i]];
+                }
+
+                c[0] = c0;
+                c[1] = c1;
+                c[2] = c2;
+                c[3] = c3;
+
+                for (int k = 0; k < 4; k++)
+                {
+                    if (!busy[k])
+                        continue;
+
+                    p[k] += len;
+                    left[k] -= len;
+
+                    if (left[k] == 0)
+                    {
+                        pCrc[idx[k]] = c[k];
+                        busy[k] = false;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Used to calculate the crc of a buffer in one call, starting
+         *        with zero.
+         * 
+         * @param pData     Pointer to the data to process.
+         * @param siz       Number of bytes to process.
+         * @return uint8_t  The crc value.
+         */
+        static uint8_t compute(const void *pData, size_t siz)
+        {
+            crc8tab crc;
+
+            return crc.calc(pData, siz);
+        }
+
+        /**
+         * @brief Used to get the crc of two concatenated buffers A and B from
+         *        the crcs of both buffers, see crc8::combine(). Together with
+         *        compute() this allows to use crcParallel().
+         * 
+         * @param crcA      The crc of buffer A.
+         * @param crcB      The crc of buffer B.
+         * @param lenB      The length of buffer B in bytes.
+         * @param init      The value both crcs have been started with.
+         * @return uint8_t  The crc of A followed by B.
+         */
+        static uint8_t combine(uint8_t crcA, uint8_t crcB, size_t lenB, 
+            uint8_t init = 0)
+        {
+            return crc8::combine(crcA, crcB, lenB, init, Poly);
+        }
+
+        /**
+         * @brief Cast to uint8_t operator used for reading the crc.
+         * 
+         * @return uint8_t  The current crc value.
+         */
+        operator uint8_t()
+        {
+            return value;
+        }
+
+    private:
+
+        /**
+         * @brief The crc value stored in this calss.
+         */
+        uint8_t value;
+};
+
+template <uint8_t Poly, unsigned Slices> 
+constexpr const uint8_t (&crc8tab<Poly, Slices>::Table)[Slices][256];
+
+#undef CRC8TAB_1
+#undef CRC8TAB_4
+#undef CRC8TAB_16
+#undef CRC8TAB_64
+#undef CRC8TAB_256
+#undef CRC8TAB_4X
+
+#endif /* GENERIC_CRC8TAB_HPP_ */
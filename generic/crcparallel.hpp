@@ -0,0 +1,107 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_CRCPARALLEL_HPP_
+#define GENERIC_CRCPARALLEL_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <thread>
+#include <vector>
+
+#include "generic/crc.hpp"
+
+/**
+ * @brief The minimum number of bytes per thread used by crcParallel().
+ */
+#ifndef CRC_PARALLEL_MIN_CHUNK
+#define CRC_PARALLEL_MIN_CHUNK          (256 * 1024)
+#endif
+
+/**
+ * @brief Calculates the crc of a large buffer using several threads.
+ * 
+ * The buffer is split into one chunk per thread, the crcs of the chunks are 
+ * calculated in parallel and merged by Crc::combine(). Works with crcModel and
+ * crc8tab, which provide compute() and combine(). Buffers too small
+ * to give every thread at least CRC_PARALLEL_MIN_CHUNK bytes use less threads.
+ * 
+ *  uint32_t val = crcParallel<crc32IsoHdlc>(pFile, fileSize);
+ * 
+ * Needs a hosted environment with std::thread.
+ * 
+ * @param pData     Pointer to the data to process.
+ * @param siz       Number of bytes to process.
+ * @param threads   The number of threads to use. Defaults to the number of 
+ *                  hardware threads.
+ * @return The crc value.
+ */
+template <class Crc> typename Crc::value_t crcParallel(const void *pData, 
+    size_t siz, unsigned threads = 0)
+{
+    const uint8_t *tmp = (const uint8_t *)pData;
+    size_t chunk = 0;
+    typename Crc::value_t res = 0;
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if (threads > siz / CRC_PARALLEL_MIN_CHUNK)
+        threads = siz / CRC_PARALLEL_MIN_CHUNK;
+
+    if (threads <= 1)
+        return Crc::compute(pData, siz);
+
+    chunk = siz / threads;
+
+    std::vector<typename Crc::value_t> part(threads);
+    std::vector<std::thread> pool;
+
+    /* The calling thread takes the last chunk, including the remainder. */
+    for (unsigned i = 0; i < threads - 1; i++)
+    {
+        pool.emplace_back([&part, tmp, chunk, i]()
+        {
+            part[i] = Crc::compute(tmp + i * chunk, chunk);
+        });
+    }
+
+    part[threads - 1] = Crc::compute(tmp + (threads - 1) * chunk, 
+        siz - (threads - 1) * chunk);
+
+    for (std::thread &t : pool)
+    {
+        t.join();
+    }
+
+    res = part[0];
+
+    for (unsigned i = 1; i < threads - 1; i++)
+    {
+        res = Crc::combine(res, part[i], chunk);
+    }
+
+    return Crc::combine(res, part[threads - 1], siz - (threads - 1) * chunk);
+}
+
+#endif /* GENERIC_CRCPARALLEL_HPP_ */
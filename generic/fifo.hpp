@@ -26,8 +26,109 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#ifndef FIFO_CACHELINE_SIZE
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(__arm64__)
+/**
+ * @brief Used to place the producer and the consumer index on different cache 
+ * lines on hosted targets, to avoid false sharing between the two threads.
+ */
+#define FIFO_CACHELINE_SIZE             64
+#else
+/**
+ * @brief Micro controllers do not have a data cache worth mentioning, so there 
+ * is no need to waste RAM on padding.
+ */
+#define FIFO_CACHELINE_SIZE             sizeof(size_t)
+#endif
+#endif
+
+/**
+ * Describes a contiguous block of fifo memory, comparable to struct iovec.
+ */
+struct FifoBlock
+{
+    /**
+     * Start of the block.
+     */
+    void *pBuf;
+
+    /**
+     * Size of the block in bytes.
+     */
+    size_t Size;
+};
+
+#ifdef FIFO_STATS
+/**
+ * Statistics collected by a Fifo if FIFO_STATS is defined.
+ */
+struct FifoStats
+{
+    /**
+     * The maximum number of used bytes seen.
+     */
+    size_t HighWater;
+
+    /**
+     * Total number of bytes written to the fifo.
+     */
+    size_t BytesIn;
+
+    /**
+     * Total number of bytes read or freed from the fifo.
+     */
+    size_t BytesOut;
+
+    /**
+     * Number of writes which could not store all data, as the fifo was full.
+     */
+    size_t ShortWrites;
+
+    /**
+     * Number of reads on an empty fifo.
+     */
+    size_t EmptyReads;
+
+    /**
+     * The largest number of bytes stored by a single write.
+     */
+    size_t MaxWrite;
+};
+#endif
+
 /**
  * FiFo Data structure with all data elements needed.
+ * 
+ * The fifo is lock free for exactly one producer and one consumer, which might
+ * run in different threads or in a interrupt and the main loop. The producer
+ * side (write, put) only modifies the head index and the consumer side (get, 
+ * read, free) only modifies the tail index. Both indices are published with 
+ * release semantics and observed with acquire semantics, so the data bytes are
+ * always visible before the index which covers them. One byte of the buffer is
+ * kept free to distinguish a full from an empty fifo.
+ * 
+ * In overwrite mode, see setOverwrite(), the producer also moves the tail index
+ * to drop the oldest data. Then both sides move the tail index by a compare 
+ * and swap, and get() and read() discard their copy and retry if the producer
+ * dropped the data meanwhile. So a trace buffer can be drained while the 
+ * producer keeps writing. Data accessed in place, by peek(), find(), 
+ * getReadBlock() or getReadBlocks(), might be overwritten in this mode.
+ * 
+ * To tell a read index which came back to the same position after Size bytes
+ * from the one a copy is based on, the bits of the tail index above the ones
+ * needed for Size count its moves in overwrite mode. A consumer which is 
+ * suspended during its copy for so long that this counter wraps around, e.g.
+ * 65536 moves for a 64 KiB buffer and a 32 bit size_t, could still take a 
+ * torn copy as valid.
+ * 
+ * If FIFO_STATS is defined at build time, the fifo collects statistics to size
+ * the buffer and to detect back pressure, see getStats(). The producer side 
+ * and the consumer side only update their own counters, which are kept on 
+ * separate cache lines, so no additional synchronization is needed and the 
+ * sides do not disturb each other. Without FIFO_STATS there is no overhead at 
+ * all.
+ * 
+ * Calling init() is not thread safe and must not race with any other call.
  */
 class Fifo
 {
@@ -35,15 +136,75 @@ class Fifo
 
         Fifo();
 
-        Fifo(char *buf, size_t siz);
+        Fifo(char *buf, size_t siz, bool mirrored = false);
 
         /**
          * Used to initialize the fifo.
          *
          * @param buf       The fifo buffer to operate on.
          * @param siz       The size of the provided buffer.
+         * @param mirrored  True if the buffer is mapped twice back to back in
+         *                  virtual memory, so buf[i] and buf[i + siz] refer to
+         *                  the same byte. In this case all blocks returned by 
+         *                  the fifo are contiguous, regardless of where the 
+         *                  data wraps around. See MirrorFifo.
+         */
+        void init(char *buf, size_t siz, bool mirrored = false);
+
+        /**
+         * Used to enable or disable the overwrite mode. If enabled, write() and
+         * put() always succeed and drop the oldest data if the fifo is full, 
+         * instead of truncating the new data. Must be set before the producer
+         * and the consumer start.
+         *
+         * @param val       The new overwrite state, true by default.
          */
-        void init(char *buf, size_t siz);
+        void setOverwrite(bool val = true);
+
+        /**
+         * If the overwrite mode is enabled or not.
+         *
+         * @return true     If the overwrite mode is enabled.
+         * @return false    If the overwrite mode is not enabled.
+         */
+        bool isOverwrite(void);
+
+        /**
+         * To get the number of bytes dropped in overwrite mode.
+         *
+         * @return The number of dropped bytes.
+         */
+        size_t getDropped(void);
+
+        /**
+         * To get the number of write operations which had to drop data in 
+         * overwrite mode.
+         *
+         * @return The number of overruns.
+         */
+        size_t getOverruns(void);
+
+        /**
+         * Used to reset the dropped byte and overrun counters.
+         */
+        void resetDropped(void);
+
+#ifdef FIFO_STATS
+        /**
+         * Used to get a snapshot of the statistics. Can be called from any 
+         * thread, the values are not guaranteed to be consistent among each
+         * other.
+         *
+         * @param stats     Takes the statistics.
+         */
+        void getStats(FifoStats *stats);
+
+        /**
+         * Used to reset the statistics. Must not be called concurrently to the
+         * producer or the consumer.
+         */
+        void resetStats(void);
+#endif
 
         /**
          * To get the size of the fifo during runtime.
@@ -72,10 +233,45 @@ class Fifo
          * @param buf       The provided data.
          * @param siz       The number of bytes to write.
          *
-         * @return The number of written bytes.
+         * @return The number of written bytes. In overwrite mode always siz,
+         *         even if only the last getSize() - 1 bytes are kept.
          */
         size_t write(const void *buf, size_t siz);
 
+        /**
+         * Used to get direct access to the free space of the fifo, to write
+         * data without copying it through write(). Data written to the block
+         * becomes visible to the consumer by calling commit().
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  free fifo space.
+         *
+         * @return          The number of bytes which can be written to the 
+         *                  fifo in a subsequent way.
+         */
+        size_t getWriteBlock(void **buf);
+
+        /**
+         * Used to get both blocks of free fifo space at once. The second block
+         * has a size of zero if the free space does not wrap around the end of
+         * the buffer.
+         *
+         * @param blk       The two blocks to fill.
+         *
+         * @return          The number of bytes which can be written to the 
+         *                  fifo, which is the sum of both block sizes.
+         */
+        size_t getWriteBlocks(FifoBlock blk[2]);
+
+        /**
+         * Used to publish data which has been written to the space provided by
+         * getWriteBlock() or getWriteBlocks(). The function will commit not 
+         * more bytes then free.
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz);
+
         /**
          * Used to put just one byte to the fifo.
          *
@@ -106,6 +302,69 @@ class Fifo
          */
         size_t read(void *buf, size_t siz);
 
+        /**
+         * Used to copy data from the fifo without removing it, e.g. to check a
+         * header before the data is consumed.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       Number of bytes to copy.
+         * @param offset    Number of used bytes to skip before copying.
+         *
+         * @return          The number of bytes copied.
+         */
+        size_t peek(void *buf, size_t siz, size_t offset = 0);
+
+        /**
+         * Used to search the used data for the given byte. Uses memchr() on 
+         * both blocks of used data, so no byte wise loop is needed even if the
+         * data wraps around. At most siz bytes are searched.
+         *
+         * @param c         The byte to search for.
+         * @param siz       The maximum number of bytes to search.
+         *
+         * @return          The number of bytes up to and including the first
+         *                  occurrence of c, 0 if c has not been found.
+         */
+        size_t find(char c, size_t siz = (size_t)-1);
+
+        /**
+         * Used to read one record terminated by delim from the fifo. If the 
+         * record does not fit into buf, or if the fifo holds at least siz bytes
+         * without a delimiter, siz bytes are read and the last byte read is not
+         * delim.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       The size of the target buffer.
+         * @param delim     The record delimiter, e.g. '\n'.
+         *
+         * @return          The number of bytes read including the delimiter, 0
+         *                  if no complete record is available.
+         */
+        size_t readUntil(void *buf, size_t siz, char delim);
+
+        /**
+         * Like readUntil() but the data is not removed from the fifo.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       The size of the target buffer.
+         * @param delim     The record delimiter, e.g. '\n'.
+         *
+         * @return          The number of bytes copied including the delimiter,
+         *                  0 if no complete record is available.
+         */
+        size_t peekUntil(void *buf, size_t siz, char delim);
+
+        /**
+         * Like peekUntil() with a new line as delimiter.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       The size of the target buffer.
+         *
+         * @return          The number of bytes copied including the new line,
+         *                  0 if no complete line is available.
+         */
+        size_t peekLine(void *buf, size_t siz);
+
         /**
          *
          * @param buf       A pointer to a pointer to take the address of the
@@ -116,6 +375,18 @@ class Fifo
          */
         size_t getReadBlock(void **buf);
 
+        /**
+         * Used to get both blocks of used fifo data at once. The second block
+         * has a size of zero if the used data does not wrap around the end of 
+         * the buffer.
+         *
+         * @param blk       The two blocks to fill.
+         *
+         * @return          The number of bytes which can be read from the fifo,
+         *                  which is the sum of both block sizes.
+         */
+        size_t getReadBlocks(FifoBlock blk[2]);
+
         /**
          * Used to free space in the fifo. The function will free not more bytes
          * then provided, but maybe less if less bytes are used.
@@ -127,6 +398,86 @@ class Fifo
 
     private:
 
+        /**
+         * Used by the producer in overwrite mode to drop the oldest bytes 
+         * until the given number of bytes is free.
+         *
+         * @param siz       Number of bytes needed.
+         *
+         * @return          The number of bytes dropped.
+         */
+        size_t dropOldest(size_t siz);
+
+        /**
+         * To get the number of used bytes for the given read index.
+         *
+         * @param tail      The read index.
+         *
+         * @return The number of used bytes.
+         */
+        size_t getUsed(size_t tail);
+
+        /**
+         * Used to move the read index. In overwrite mode it is only moved if
+         * it still equals tail, as the producer may move it too, and the move
+         * counter above TailMask is incremented.
+         *
+         * @param tail      The read index the caller is based on, including
+         *                  the move counter.
+         * @param next      The new read index.
+         *
+         * @return          False if the read index has been moved meanwhile.
+         */
+        bool moveTail(size_t tail, size_t next);
+
+        /**
+         * Used to determine the length of the next record, see readUntil().
+         *
+         * @param siz       The size of the target buffer.
+         * @param delim     The record delimiter.
+         *
+         * @return          The length of the record, 0 if none is available.
+         */
+        size_t getRecordLength(size_t siz, char delim);
+
+#ifdef FIFO_STATS
+        /**
+         * Used by the producer to update the statistics after a write.
+         *
+         * @param req       Number of bytes which should have been written.
+         * @param done      Number of bytes which have been written.
+         */
+        void statsIn(size_t req, size_t done);
+
+        /**
+         * Used by the consumer to update the statistics after a read.
+         *
+         * @param req       Number of bytes which should have been read.
+         * @param done      Number of bytes which have been read.
+         */
+        void statsOut(size_t req, size_t done);
+
+        /**
+         * Statistics updated by the producer.
+         */
+        struct StatsIn
+        {
+            size_t HighWater;
+            size_t BytesIn;
+            size_t ShortWrites;
+            size_t MaxWrite;
+        };
+
+        /**
+         * Statistics updated by the consumer.
+         */
+        struct StatsOut
+        {
+            size_t BytesOut;
+            size_t EmptyReads;
+        };
+#endif
+
         /**
          * The data array.
          */
@@ -138,14 +489,57 @@ class Fifo
         size_t Size;
 
         /**
-         * Write index.
+         * Mask of the bits of Tail which hold the index, the bits above count
+         * the moves of Tail in overwrite mode.
+         */
+        size_t TailMask;
+
+        /**
+         * True if the data array is mirrored in virtual memory.
+         */
+        bool Mirrored;
+
+        /**
+         * True if the oldest data shall be dropped if the fifo is full.
+         */
+        bool Overwrite;
+
+        /**
+         * Write index, only modified by the producer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Head;
+
+        /**
+         * Number of bytes dropped in overwrite mode, only modified by the 
+         * producer.
+         */
+        size_t Dropped;
+
+        /**
+         * Number of write operations which dropped data in overwrite mode, 
+         * only modified by the producer.
+         */
+        size_t Overruns;
+
+#ifdef FIFO_STATS
+        /**
+         * The statistics of the producer, on a cache line of its own.
+         */
+        alignas(FIFO_CACHELINE_SIZE) StatsIn In;
+#endif
+
+        /**
+         * Read index, only modified by the consumer, and by the producer in
+         * overwrite mode.
          */
-        volatile size_t Head;
+        alignas(FIFO_CACHELINE_SIZE) size_t Tail;
 
+#ifdef FIFO_STATS
         /**
-         * Read index.
+         * The statistics of the consumer, on a cache line of its own.
          */
-        volatile size_t Tail;
+        alignas(FIFO_CACHELINE_SIZE) StatsOut Out;
+#endif
 };
 
 #endif /* GENERIC_FIFO_HPP_ */
@@ -0,0 +1,208 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_FIFOCRC_HPP_
+#define GENERIC_FIFOCRC_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief Used to update a crc by the used data of a fifo, without reading or 
+ * copying it. Both blocks are processed in place, so data wrapping around the 
+ * end of the buffer is handled as well.
+ * 
+ * Works with crc8, crc8tab and crcModel, or any other class with a
+ * calc(void *, size_t) member:
+ * 
+ *  crc8tab<> crc;
+ *  
+ *  fifoCrc(txFifo, crc);
+ *  txFifo.put(&crc);
+ * 
+ * Must be called by the consumer, like getReadBlocks().
+ * 
+ * @param fifo      The fifo to use.
+ * @param crc       The crc to update.
+ * @param offset    Number of used bytes to skip.
+ * @param siz       Maximum number of bytes to process. Defaults to all.
+ * 
+ * @return The number of bytes processed.
+ */
+template <class Crc> size_t fifoCrc(Fifo &fifo, Crc &crc, size_t offset = 0,
+    size_t siz = (size_t)-1)
+{
+    FifoBlock blk[2];
+    size_t done = 0;
+
+    fifo.getReadBlocks(blk);
+
+    for (int i = 0; i < 2 && done < siz; i++)
+    {
+        size_t len = blk[i].Size;
+
+        if (offset >= len)
+        {
+            offset -= len;
+            continue;
+        }
+
+        len -= offset;
+
+        if (len > siz - done)
+            len = siz - done;
+
+        crc.calc((char *)blk[i].pBuf + offset, len);
+        offset = 0;
+        done += len;
+    }
+
+    return done;
+}
+
+/**
+ * @brief Writes to a fifo and maintains the crc of all data written.
+ * 
+ * The crc is updated while the data is at hand, so there is no second pass 
+ * over the fifo to get it. Data written in place by getWriteBlocks() is 
+ * processed by commit().
+ * 
+ *  FifoCrcWriter<crc8tab<> > tx(txFifo);
+ *  
+ *  tx.write(&hdr, sizeof(hdr));
+ *  tx.write(pPayload, len);
+ *  crc = tx.getCrc();
+ * 
+ * The writer takes the role of the producer of the fifo.
+ */
+template <class Crc> class FifoCrcWriter
+{
+    public:
+
+        /**
+         * @brief Construct a new FifoCrcWriter object.
+         * 
+         * @param fifo      The fifo to write to.
+         * @param crc       The initial crc.
+         */
+        FifoCrcWriter(Fifo &fifo, const Crc &crc = Crc()) :
+              pFifo(&fifo)
+            , Value(crc)
+        {
+
+        }
+
+        /**
+         * To get the crc of all data written so far.
+         *
+         * @return The crc.
+         */
+        Crc &getCrc(void)
+        {
+            return Value;
+        }
+
+        /**
+         * Used to write a given number of bytes to the fifo, see 
+         * Fifo::write().
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz)
+        {
+            siz = pFifo->write(buf, siz);
+            Value.calc((void *)buf, siz);
+
+            return siz;
+        }
+
+        /**
+         * Used to put just one byte to the fifo.
+         *
+         * @param c         The byte to write to the fifo.
+         *
+         * @return The number of bytes written (0/1).
+         */
+        size_t put(const void *c)
+        {
+            return write(c, 1);
+        }
+
+        /**
+         * Used to get direct access to the free space of the fifo, see 
+         * Fifo::getWriteBlocks().
+         *
+         * @param blk       Takes the two free blocks.
+         *
+         * @return          The number of free bytes.
+         */
+        size_t getWriteBlocks(FifoBlock blk[2])
+        {
+            return pFifo->getWriteBlocks(blk);
+        }
+
+        /**
+         * Used to update the crc by the data written to the free blocks and to
+         * publish it.
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz)
+        {
+            FifoBlock blk[2];
+            size_t avail = pFifo->getWriteBlocks(blk);
+
+            if (siz > avail)
+                siz = avail;
+
+            if (siz > blk[0].Size)
+            {
+                Value.calc(blk[0].pBuf, blk[0].Size);
+                Value.calc(blk[1].pBuf, siz - blk[0].Size);
+            }
+            else
+            {
+                Value.calc(blk[0].pBuf, siz);
+            }
+
+            pFifo->commit(siz);
+        }
+
+    private:
+
+        /**
+         * The fifo to write to.
+         */
+        Fifo *pFifo;
+
+        /**
+         * The crc of all data written.
+         */
+        Crc Value;
+};
+
+#endif /* GENERIC_FIFOCRC_HPP_ */
@@ -0,0 +1,60 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_FIFOIO_HPP_
+#define GENERIC_FIFOIO_HPP_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/types.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * Used to read as much data as fits into the fifo from a file descriptor. Both
+ * blocks of free fifo space are filled by a single readv() call.
+ *
+ * @param fifo      The fifo to fill.
+ * @param fd        The file descriptor to read from.
+ *
+ * @return          The number of bytes added to the fifo, 0 on end of file or
+ *                  -1 on error with errno set. If the fifo is full, -1 is 
+ *                  returned and errno is set to ENOBUFS.
+ */
+ssize_t fifoFill(Fifo &fifo, int fd);
+
+/**
+ * Used to write as much fifo data as possible to a file descriptor. Both 
+ * blocks of used fifo data are passed to a single writev() call and the 
+ * written bytes are freed.
+ *
+ * @param fifo      The fifo to drain.
+ * @param fd        The file descriptor to write to.
+ *
+ * @return          The number of bytes removed from the fifo, 0 if the fifo is
+ *                  empty or -1 on error with errno set.
+ */
+ssize_t fifoDrain(Fifo &fifo, int fd);
+
+#endif /* __unix__ || __APPLE__ */
+
+#endif /* GENERIC_FIFOIO_HPP_ */
@@ -0,0 +1,223 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_FIFORANGE_HPP_
+#define GENERIC_FIFORANGE_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <iterator>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A read only view of the used data of a Fifo.
+ * 
+ * The range takes both blocks of used data at construction and provides a 
+ * forward iterator which walks over them, across the wrap around, without 
+ * copying any data. Hence it can be used with standard algorithms to inspect 
+ * the fifo before its data is consumed:
+ * 
+ *  FifoRange range(fifo);
+ *  const char hdr[] = { 'H', 'D', 'R' };
+ * 
+ *  if (range.size() >= sizeof(hdr) && 
+ *      std::equal(hdr, hdr + sizeof(hdr), range.begin()))
+ *  {
+ *      ...
+ *  }
+ * 
+ * The range covers the data used at the time of its construction. The 
+ * producer may continue to write, but the consumer must not read or free data
+ * as long as the range is in use.
+ */
+class FifoRange
+{
+    public:
+
+        /**
+         * Iterates over the bytes of both blocks.
+         */
+        class Iterator
+        {
+            public:
+
+                typedef std::forward_iterator_tag iterator_category;
+                typedef char value_type;
+                typedef ptrdiff_t difference_type;
+                typedef const char *pointer;
+                typedef const char &reference;
+
+                Iterator() :
+                      pPos(0)
+                    , pEnd(0)
+                    , pNext(0)
+                    , pNextEnd(0)
+                {
+
+                }
+
+                reference operator*() const
+                {
+                    return *pPos;
+                }
+
+                Iterator &operator++()
+                {
+                    if (++pPos == pEnd && pNext)
+                    {
+                        pPos = pNext;
+                        pEnd = pNextEnd;
+                        pNext = 0;
+                    }
+
+                    return *this;
+                }
+
+                Iterator operator++(int)
+                {
+                    Iterator tmp = *this;
+
+                    ++(*this);
+
+                    return tmp;
+                }
+
+                bool operator==(const Iterator &other) const
+                {
+                    return pPos == other.pPos;
+                }
+
+                bool operator!=(const Iterator &other) const
+                {
+                    return pPos != other.pPos;
+                }
+
+            private:
+
+                friend class FifoRange;
+
+                /**
+                 * The current position.
+                 */
+                const char *pPos;
+
+                /**
+                 * End of the current block.
+                 */
+                const char *pEnd;
+
+                /**
+                 * Start of the second block, zero if there is none left.
+                 */
+                const char *pNext;
+
+                /**
+                 * End of the second block.
+                 */
+                const char *pNextEnd;
+        };
+
+        typedef Iterator iterator;
+        typedef Iterator const_iterator;
+
+        /**
+         * @brief Construct a new FifoRange object.
+         * 
+         * @param fifo      The fifo to view.
+         */
+        FifoRange(Fifo &fifo)
+        {
+            Used = fifo.getReadBlocks(Blk);
+        }
+
+        /**
+         * To get the number of bytes in the range.
+         *
+         * @return The number of bytes.
+         */
+        size_t size(void) const
+        {
+            return Used;
+        }
+
+        /**
+         * To check if the range is empty.
+         *
+         * @return true if there are no bytes in the range.
+         */
+        bool empty(void) const
+        {
+            return Used == 0;
+        }
+
+        /**
+         * To get a iterator to the oldest byte.
+         *
+         * @return The iterator.
+         */
+        Iterator begin(void) const
+        {
+            Iterator it;
+
+            it.pPos = (const char *)Blk[0].pBuf;
+            it.pEnd = it.pPos + Blk[0].Size;
+
+            if (Blk[1].Size)
+            {
+                it.pNext = (const char *)Blk[1].pBuf;
+                it.pNextEnd = it.pNext + Blk[1].Size;
+            }
+
+            return it;
+        }
+
+        /**
+         * To get a iterator behind the newest byte.
+         *
+         * @return The iterator.
+         */
+        Iterator end(void) const
+        {
+            Iterator it;
+            int last = Blk[1].Size ? 1 : 0;
+
+            it.pPos = (const char *)Blk[last].pBuf + Blk[last].Size;
+            it.pEnd = it.pPos;
+
+            return it;
+        }
+
+    private:
+
+        /**
+         * The blocks of used data.
+         */
+        FifoBlock Blk[2];
+
+        /**
+         * The total number of bytes.
+         */
+        size_t Used;
+};
+
+#endif /* GENERIC_FIFORANGE_HPP_ */
@@ -0,0 +1,193 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_FILEFIFO_HPP_
+#define GENERIC_FILEFIFO_HPP_
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/shmfifo.hpp"
+
+/**
+ * @brief A persistent fifo stored in a memory mapped file on Linux.
+ * 
+ * Uses the same layout as ShmFifo, but in a regular file, so the queued data 
+ * survives a restart of the process and the fifo is available again right 
+ * after open(). 
+ * 
+ * Flushing the mapping to disk is expensive, so it is batched: sync() flushes
+ * the data and then records the current indices as checkpoint. It is called 
+ * by close() and automatically by the producer after the number of bytes set 
+ * by setSyncInterval() has been written.
+ * 
+ * If the fifo has been closed properly, open() continues with the last 
+ * indices. Otherwise it falls back to the last checkpoint, which is known to 
+ * be consistent with the data on disk: data written after the last sync() is
+ * lost and data read after it is delivered again.
+ * 
+ * To keep the data of the checkpoint, the producer does not overwrite space 
+ * freed by the consumer after the last sync(). If it runs short of space for 
+ * this reason, write() and getWriteBlock() call sync() first.
+ * 
+ * Like ShmFifo it can be used by one producer and one consumer, also in 
+ * different processes, but only one of them may open the file by this class
+ * and this has to be the producer.
+ */
+class FileFifo : public ShmFifo
+{
+    public:
+
+        FileFifo();
+
+        /**
+         * @brief Destroy the FileFifo object, see close().
+         */
+        ~FileFifo();
+
+        /**
+         * Used to open a fifo file. If the file does not exist or is empty, a 
+         * new fifo is created. Otherwise the fifo is recovered as described 
+         * in the class documentation.
+         *
+         * @param path      The path of the file.
+         * @param siz       The size of the data buffer for a new fifo.
+         *
+         * @return          True on success, false if the file could not be 
+         *                  opened or contains no fifo of a compatible version.
+         */
+        bool open(const char *path, size_t siz);
+
+        /**
+         * Used to sync the fifo to disk and close it.
+         */
+        void close(void);
+
+        /**
+         * If the fifo had been closed properly before it has been opened.
+         *
+         * @return true     If the last indices have been used.
+         * @return false    If the fifo has been recovered from a checkpoint or
+         *                  has been created.
+         */
+        bool wasClean(void);
+
+        /**
+         * Used to set the number of written bytes after which the producer 
+         * calls sync().
+         *
+         * @param siz       The number of bytes, 0 to disable automatic syncs.
+         */
+        void setSyncInterval(size_t siz);
+
+        /**
+         * Used to flush the data to disk and to write a new checkpoint.
+         *
+         * @return          True on success.
+         */
+        bool sync(void);
+
+        /**
+         * Used to write a given number of bytes from to the fifo, see 
+         * ShmFifo::write().
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         * Used to get direct access to the free space of the fifo, see 
+         * ShmFifo::getWriteBlock().
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  free fifo space.
+         *
+         * @return          The number of bytes which can be written to the 
+         *                  fifo in a subsequent way.
+         */
+        size_t getWriteBlock(void **buf);
+
+        /**
+         * Used to publish data which has been written to the space provided by
+         * getWriteBlock(), see ShmFifo::commit().
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz);
+
+    private:
+
+        /**
+         * Used to restore consistent indices after the file has been mapped.
+         *
+         * @return          True on success, false if the file contains no 
+         *                  compatible fifo.
+         */
+        bool recover(void);
+
+        /**
+         * Used to calculate the crc of the checkpoint indices.
+         *
+         * @param head      The write index of the checkpoint.
+         * @param tail      The read index of the checkpoint.
+         *
+         * @return          The crc.
+         */
+        uint32_t getSyncCrc(uint64_t head, uint64_t tail);
+
+        /**
+         * Used by the producer to call sync() if less than siz bytes are free
+         * because space freed since the last checkpoint is kept.
+         *
+         * @param siz       The number of bytes the producer wants to write.
+         */
+        void makeRoom(size_t siz);
+
+        /**
+         * Used by the producer to account written bytes.
+         */
+        void addDirty(size_t siz);
+
+        /**
+         * True if the fifo had been closed properly.
+         */
+        bool Clean;
+
+        /**
+         * The number of bytes after which sync() is called.
+         */
+        size_t SyncInterval;
+
+        /**
+         * The number of bytes written since the last sync().
+         */
+        size_t Dirty;
+};
+
+#endif /* __linux__ */
+
+#endif /* GENERIC_FILEFIFO_HPP_ */
@@ -0,0 +1,348 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_FRAMING_HPP_
+#define GENERIC_FRAMING_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+#include "generic/crc8tab.hpp"
+
+/**
+ * @brief The special bytes of SLIP, see RFC 1055.
+ */
+#define SLIP_END                        0xC0
+#define SLIP_ESC                        0xDB
+#define SLIP_ESC_END                    0xDC
+#define SLIP_ESC_ESC                    0xDD
+
+/**
+ * @brief The largest COBS code, a block of 254 bytes without a zero.
+ */
+#define COBS_CODE_MAX                   0xFF
+
+/**
+ * @brief The crc8 used for the trailer of all frames. Uses four slices, as 
+ * runs of payload are processed at once.
+ */
+typedef crc8tab<CRC8_POLY_DEFAULT, 4> FrameCrc;
+
+/**
+ * @brief Common part of the frame decoders.
+ * 
+ * A decoder writes the decoded bytes of a frame directly to the free space of 
+ * the output fifo, but commits them only if the frame is complete and its 
+ * crc8 trailer is valid. So the output fifo needs one byte more free space 
+ * than the largest payload, frames which can never fit are dropped. If the 
+ * output fifo is just full for the moment, decoding stops and continues with
+ * the same frame on the next call.
+ */
+class FrameDecoder
+{
+    public:
+
+        FrameDecoder();
+
+        /**
+         * Used to drop the frame currently decoded.
+         */
+        void reset(void);
+
+        /**
+         * To get the number of frames dropped because of a wrong crc, an 
+         * invalid encoding or a too small output fifo.
+         *
+         * @return The number of errors.
+         */
+        size_t getErrors(void);
+
+    protected:
+
+        /**
+         * Used to append decoded bytes to the current frame.
+         *
+         * @param out       The output fifo.
+         * @param blk       The free blocks of the output fifo.
+         * @param avail     The number of free bytes of the output fifo.
+         * @param buf       The decoded data.
+         * @param siz       The number of bytes.
+         *
+         * @return The number of bytes consumed, less than siz if the output 
+         *         fifo is full.
+         */
+        size_t store(Fifo &out, const FifoBlock blk[2], size_t avail, 
+            const void *buf, size_t siz);
+
+        /**
+         * Used to mark the current frame as invalid.
+         */
+        void error(void);
+
+        /**
+         * Used to complete the current frame. Empty frames are ignored.
+         *
+         * @param out       The output fifo.
+         *
+         * @return The payload length if the frame is valid, otherwise 0.
+         */
+        size_t endFrame(Fifo &out);
+
+        /**
+         * The crc of the decoded bytes of the current frame.
+         */
+        FrameCrc Crc;
+
+        /**
+         * Number of decoded bytes of the current frame, including the crc.
+         */
+        size_t Pending;
+
+        /**
+         * True if the current frame is invalid and will be dropped.
+         */
+        bool Drop;
+
+        /**
+         * Number of dropped frames.
+         */
+        size_t Errors;
+};
+
+/**
+ * @brief Streaming SLIP encoder which appends a crc8 to every frame.
+ * 
+ * The payload is taken from one fifo and written to another, runs of bytes 
+ * which need no escaping are found by memchr() and copied as a whole. The 
+ * encoder can be called with any part of the payload, if the output fifo is 
+ * full it just returns and continues with the next call.
+ * 
+ *  SlipEncoder enc;
+ *  
+ *  enc.encode(txData, txLine, frameLen);
+ *  while (!enc.finish(txLine))
+ *      ...
+ */
+class SlipEncoder
+{
+    public:
+
+        SlipEncoder();
+
+        /**
+         * Used to drop the frame currently encoded.
+         */
+        void reset(void);
+
+        /**
+         * Used to encode payload of the current frame.
+         *
+         * @param in        The fifo providing the payload.
+         * @param out       The fifo to write the encoded data to.
+         * @param siz       Maximum number of payload bytes to take from in.
+         *
+         * @return The number of payload bytes taken from in.
+         */
+        size_t encode(Fifo &in, Fifo &out, size_t siz = (size_t)-1);
+
+        /**
+         * Used to complete the current frame by the crc and the end byte.
+         *
+         * @param out       The fifo to write the encoded data to.
+         *
+         * @return false if out has not enough space, then call again later.
+         */
+        bool finish(Fifo &out);
+
+    private:
+
+        /**
+         * The crc of the payload of the current frame.
+         */
+        FrameCrc Crc;
+};
+
+/**
+ * @brief Streaming SLIP decoder which checks the crc8 trailer of every frame.
+ * 
+ * Decodes the data of one fifo and writes the payload of valid frames to 
+ * another. It returns as soon as one frame is complete, so the caller knows 
+ * the length of each frame in the output fifo:
+ * 
+ *  SlipDecoder dec;
+ *  size_t len;
+ *  
+ *  while ((len = dec.decode(rxLine, rxData)) > 0)
+ *  {
+ *      rxData.read(frame, len);
+ *      ...
+ *  }
+ * 
+ * Partial frames are kept, the decoder continues with the next call.
+ */
+class SlipDecoder : public FrameDecoder
+{
+    public:
+
+        SlipDecoder();
+
+        /**
+         * Used to drop the frame currently decoded.
+         */
+        void reset(void);
+
+        /**
+         * Used to decode the data of a fifo until a frame is complete.
+         *
+         * @param in        The fifo providing the encoded data.
+         * @param out       The fifo to write the payload to.
+         *
+         * @return The payload length of a complete frame, 0 if in has been 
+         *         consumed without completing a frame or if out is full.
+         */
+        size_t decode(Fifo &in, Fifo &out);
+
+    private:
+
+        /**
+         * Used to decode the byte following an escape byte, which must not be
+         * an end byte.
+         *
+         * @return false if the output fifo is full.
+         */
+        bool unescape(Fifo &out, const FifoBlock blk[2], size_t avail, 
+            uint8_t c);
+
+        /**
+         * True if the last byte has been an escape byte.
+         */
+        bool Esc;
+};
+
+/**
+ * @brief Streaming COBS encoder which appends a crc8 to every frame.
+ * 
+ * Frames are terminated by a zero byte, see "Consistent Overhead Byte 
+ * Stuffing" by Stuart Cheshire and Mary Baker. Works like SlipEncoder. Each 
+ * block is written to the free space of the output fifo and committed when 
+ * its length byte is known, so the output fifo must be able to hold at least
+ * 256 bytes.
+ */
+class CobsEncoder
+{
+    public:
+
+        CobsEncoder();
+
+        /**
+         * Used to drop the frame currently encoded.
+         */
+        void reset(void);
+
+        /**
+         * Used to encode payload of the current frame.
+         *
+         * @param in        The fifo providing the payload.
+         * @param out       The fifo to write the encoded data to.
+         * @param siz       Maximum number of payload bytes to take from in.
+         *
+         * @return The number of payload bytes taken from in.
+         */
+        size_t encode(Fifo &in, Fifo &out, size_t siz = (size_t)-1);
+
+        /**
+         * Used to complete the current frame by the crc and the zero byte.
+         *
+         * @param out       The fifo to write the encoded data to.
+         *
+         * @return false if out has not enough space, then call again later.
+         */
+        bool finish(Fifo &out);
+
+    private:
+
+        /**
+         * Used to encode the given bytes.
+         *
+         * @return The number of bytes encoded.
+         */
+        size_t put(Fifo &out, const uint8_t *buf, size_t siz);
+
+        /**
+         * Used to write the code byte of the current block and commit it.
+         */
+        void close(Fifo &out, const FifoBlock blk[2]);
+
+        /**
+         * The crc of the payload of the current frame.
+         */
+        FrameCrc Crc;
+
+        /**
+         * Number of bytes of the current block, without the code byte.
+         */
+        size_t Pending;
+};
+
+/**
+ * @brief Streaming COBS decoder which checks the crc8 trailer of every frame.
+ * 
+ * Works like SlipDecoder.
+ */
+class CobsDecoder : public FrameDecoder
+{
+    public:
+
+        CobsDecoder();
+
+        /**
+         * Used to drop the frame currently decoded.
+         */
+        void reset(void);
+
+        /**
+         * Used to decode the data of a fifo until a frame is complete.
+         *
+         * @param in        The fifo providing the encoded data.
+         * @param out       The fifo to write the payload to.
+         *
+         * @return The payload length of a complete frame, 0 if in has been 
+         *         consumed without completing a frame or if out is full.
+         */
+        size_t decode(Fifo &in, Fifo &out);
+
+    private:
+
+        /**
+         * Number of bytes left in the current block.
+         */
+        uint8_t Code;
+
+        /**
+         * True if a zero byte follows the current block, unless the frame 
+         * ends.
+         */
+        bool Zero;
+};
+
+#endif /* GENERIC_FRAMING_HPP_ */
@@ -23,6 +23,8 @@
 #ifndef GENERIC_HPP_
 #define GENERIC_HPP_
 
+#include "generic/atomic.hpp"
+
 
 #ifndef PI
 /**
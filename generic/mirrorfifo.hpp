@@ -0,0 +1,89 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_MIRRORFIFO_HPP_
+#define GENERIC_MIRRORFIFO_HPP_
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A Fifo which allocates its own, virtually mirrored data buffer.
+ * 
+ * The buffer is a memfd which is mapped twice, back to back, into the address
+ * space. Hence every block returned by getReadBlock() and getWriteBlock() 
+ * covers all used data respectively all free space, no matter where the data 
+ * wraps around, and parsers can run over the used data as a linear buffer. 
+ * 
+ * The size is rounded up to a multiple of the page size. Only available on 
+ * Linux.
+ */
+class MirrorFifo : public Fifo
+{
+    public:
+
+        MirrorFifo();
+
+        /**
+         * @brief Destroy the MirrorFifo object and unmap the buffer.
+         */
+        ~MirrorFifo();
+
+        /**
+         * Used to allocate and map the mirrored buffer. An existing buffer is
+         * released before.
+         *
+         * @param siz       The minimum size of the fifo buffer.
+         *
+         * @return          True on success, false if the mapping failed.
+         */
+        bool create(size_t siz);
+
+        /**
+         * Used to release the mirrored buffer. The fifo has a size of zero
+         * afterwards.
+         */
+        void destroy(void);
+
+    private:
+
+        MirrorFifo(const MirrorFifo &);
+        MirrorFifo &operator=(const MirrorFifo &);
+
+        /**
+         * Start of both mappings.
+         */
+        char *pMap;
+
+        /**
+         * Size of a single mapping.
+         */
+        size_t MapSize;
+};
+
+#endif /* __linux__ */
+
+#endif /* GENERIC_MIRRORFIFO_HPP_ */
@@ -0,0 +1,205 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_MPMCQUEUE_HPP_
+#define GENERIC_MPMCQUEUE_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/atomic.hpp"
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A bounded queue of N elements for any number of producers and 
+ * consumers.
+ * 
+ * Implements the array based queue of Dmitry Vyukov: every slot carries a 
+ * sequence number which tells whether the slot is ready to be written or read
+ * in the current round. Producers and consumers claim a slot by a single 
+ * compare and swap of the enqueue respectively dequeue position and then only
+ * touch this slot, so there is no global lock and a stalled thread only blocks
+ * the one slot it has claimed.
+ * 
+ * T has to be default constructible and assignable, N has to be a power of 
+ * two.
+ * 
+ *  struct Job { uint32_t id; uint32_t arg; };
+ *  MpmcQueue<Job, 64> jobs;
+ * 
+ *  void producer(Job &job)
+ *  {
+ *      while (!jobs.push(job));
+ *  }
+ * 
+ *  void worker(void)
+ *  {
+ *      Job job;
+ * 
+ *      if (jobs.pop(job))
+ *          process(job);
+ *  }
+ */
+template <typename T, size_t N> class MpmcQueue
+{
+    public:
+
+        MpmcQueue() :
+              EnqueuePos(0)
+            , DequeuePos(0)
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                Cells[i].Sequence = i;
+            }
+        }
+
+        /**
+         * To get the capacity of the queue.
+         *
+         * @return The number of elements the queue can hold.
+         */
+        static size_t getSize(void)
+        {
+            return N;
+        }
+
+        /**
+         * Used to add a element to the queue.
+         *
+         * @param val       The element to add.
+         *
+         * @return          True on success, false if the queue is full.
+         */
+        bool push(const T &val)
+        {
+            size_t pos = loadRelaxed(EnqueuePos);
+            Cell *cell = 0;
+
+            while (true)
+            {
+                cell = &Cells[pos & (N - 1)];
+                size_t seq = loadAcquire(cell->Sequence);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+                if (diff == 0)
+                {
+                    if (compareExchangeRelaxed(EnqueuePos, pos, pos + 1))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = loadRelaxed(EnqueuePos);
+                }
+            }
+
+            cell->Data = val;
+            storeRelease(cell->Sequence, pos + 1);
+
+            return true;
+        }
+
+        /**
+         * Used to take the oldest element from the queue.
+         *
+         * @param val       Takes the element.
+         *
+         * @return          True on success, false if the queue is empty.
+         */
+        bool pop(T &val)
+        {
+            size_t pos = loadRelaxed(DequeuePos);
+            Cell *cell = 0;
+
+            while (true)
+            {
+                cell = &Cells[pos & (N - 1)];
+                size_t seq = loadAcquire(cell->Sequence);
+                intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (compareExchangeRelaxed(DequeuePos, pos, pos + 1))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = loadRelaxed(DequeuePos);
+                }
+            }
+
+            val = cell->Data;
+            storeRelease(cell->Sequence, pos + N);
+
+            return true;
+        }
+
+    private:
+
+        static_assert(N >= 2 && (N & (N - 1)) == 0, 
+            "MpmcQueue needs a power of two capacity");
+
+        MpmcQueue(const MpmcQueue &);
+        MpmcQueue &operator=(const MpmcQueue &);
+
+        /**
+         * A queue slot.
+         */
+        struct Cell
+        {
+            /**
+             * Equals the position of the slot if it is free to be written 
+             * and position + 1 if it holds data to be read.
+             */
+            size_t Sequence;
+
+            /**
+             * The element stored in this slot.
+             */
+            T Data;
+        };
+
+        /**
+         * The queue slots.
+         */
+        alignas(FIFO_CACHELINE_SIZE) Cell Cells[N];
+
+        /**
+         * Position of the next slot to write.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t EnqueuePos;
+
+        /**
+         * Position of the next slot to read.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t DequeuePos;
+};
+
+#endif /* GENERIC_MPMCQUEUE_HPP_ */
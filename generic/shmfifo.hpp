@@ -0,0 +1,353 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_SHMFIFO_HPP_
+#define GENERIC_SHMFIFO_HPP_
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief The version of the shared memory layout used by ShmFifo.
+ */
+#define SHMFIFO_VERSION                 2
+
+/**
+ * @brief A fifo in shared memory to pass data between processes on Linux.
+ * 
+ * The indices, the size and a version tag are stored in a header in front of
+ * the data, both located in a shared memory object. One process creates the 
+ * fifo, either as named POSIX shared memory object or as anonymous memfd whose
+ * file descriptor is passed to the other process, and the other process opens
+ * it. Afterwards data is passed without any system call and, by the block 
+ * functions, without copying.
+ * 
+ * Like Fifo it is lock free for one producer and one consumer, the indices are
+ * published with release and observed with acquire semantics.
+ * 
+ *  Producer:                           Consumer:
+ *  ShmFifo fifo;                       ShmFifo fifo;
+ *  fifo.create("/myfifo", 65536);      fifo.open("/myfifo");
+ *  fifo.write(data, len);              len = fifo.read(buf, sizeof(buf));
+ */
+class ShmFifo
+{
+    public:
+
+        ShmFifo();
+
+        /**
+         * @brief Destroy the ShmFifo object, see close().
+         */
+        ~ShmFifo();
+
+        /**
+         * Used to create and initialize a new named shared memory fifo. Fails
+         * if an object of the same name exists, as other processes might 
+         * still use it. Remove it by unlink() first.
+         *
+         * @param name      The name of the shared memory object, see 
+         *                  shm_open().
+         * @param siz       The size of the fifo data buffer.
+         *
+         * @return          True on success.
+         */
+        bool create(const char *name, size_t siz);
+
+        /**
+         * Used to create and initialize a new anonymous shared memory fifo. 
+         * Pass getFd() to the other process to share it.
+         *
+         * @param siz       The size of the fifo data buffer.
+         *
+         * @return          True on success.
+         */
+        bool create(size_t siz);
+
+        /**
+         * Used to open a named shared memory fifo created by another process.
+         *
+         * @param name      The name of the shared memory object.
+         *
+         * @return          True on success, false if it does not exist or if
+         *                  it is no valid fifo.
+         */
+        bool open(const char *name);
+
+        /**
+         * Used to open a shared memory fifo by a file descriptor received from
+         * another process. The descriptor is duplicated.
+         *
+         * @param fd        The file descriptor.
+         *
+         * @return          True on success, false if it is no valid fifo.
+         */
+        bool open(int fd);
+
+        /**
+         * Used to unmap the fifo and to close the file descriptor.
+         */
+        void close(void);
+
+        /**
+         * Used to remove a named shared memory fifo. Processes which have it
+         * opened can continue to use it.
+         *
+         * @param name      The name of the shared memory object.
+         *
+         * @return          True on success.
+         */
+        static bool unlink(const char *name);
+
+        /**
+         * To get the file descriptor of the shared memory object.
+         *
+         * @return The file descriptor or -1 if not opened.
+         */
+        int getFd(void);
+
+        /**
+         * To get the size of the fifo during runtime.
+         *
+         * @return The data buffer size in bytes.
+         */
+        size_t getSize(void);
+
+        /**
+         * To get the amount of used fifo data buffer space.
+         *
+         * @return The number of used bytes.
+         */
+        size_t getUsed(void);
+
+        /**
+         * To get the amount of free fifo data buffer space.
+         *
+         * @return the number of free bytes.
+         */
+        size_t getFree(void);
+
+        /**
+         * Used to write a given number of bytes from to the fifo.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         * Used to get direct access to the free space of the fifo.
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  free fifo space.
+         *
+         * @return          The number of bytes which can be written to the 
+         *                  fifo in a subsequent way.
+         */
+        size_t getWriteBlock(void **buf);
+
+        /**
+         * Used to publish data which has been written to the space provided by
+         * getWriteBlock().
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz);
+
+        /**
+         * Used to copy data from the fifo to the provided buffer.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       Number of bytes to read.
+         *
+         * @return          The number of bytes read.
+         */
+        size_t read(void *buf, size_t siz);
+
+        /**
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  fifo data
+         *
+         * @return          The number of bytes which can be read from the fifo
+         *                  in a subsequent way.
+         */
+        size_t getReadBlock(void **buf);
+
+        /**
+         * Used to free space in the fifo. 
+         *
+         * @param siz       Number of bytes to free.
+         */
+        void free(size_t siz);
+
+    protected:
+
+        /**
+         * The header at the start of the shared memory. As the layout is 
+         * shared between processes, it uses fixed size types and a fixed 
+         * alignment to keep the indices on separate cache lines.
+         */
+        struct Header
+        {
+            /**
+             * Identifies a initialized fifo.
+             */
+            uint32_t Magic;
+
+            /**
+             * The layout version, see SHMFIFO_VERSION.
+             */
+            uint32_t Version;
+
+            /**
+             * Size of the data buffer.
+             */
+            uint64_t Size;
+
+            /**
+             * Write index, only modified by the producer.
+             */
+            alignas(64) uint64_t Head;
+
+            /**
+             * Read index, only modified by the consumer.
+             */
+            alignas(64) uint64_t Tail;
+
+            /**
+             * Write index of the last checkpoint, see FileFifo::sync().
+             */
+            alignas(64) uint64_t SyncHead;
+
+            /**
+             * Read index of the last checkpoint.
+             */
+            uint64_t SyncTail;
+
+            /**
+             * The crc8 of both checkpoint indices.
+             */
+            uint32_t SyncCrc;
+
+            /**
+             * Set if the fifo has been closed properly by FileFifo.
+             */
+            uint32_t Clean;
+        };
+
+        /**
+         * Used to map the shared memory object.
+         *
+         * @param fd        The file descriptor, owned by this object now.
+         * @param siz       The size of the data buffer if a new and empty 
+         *                  object shall be initialized, 0 to open a existing 
+         *                  fifo.
+         * @param check     If the header of a existing fifo has to be valid,
+         *                  see isValid().
+         *
+         * @return          True on success.
+         */
+        bool attach(int fd, size_t siz, bool check = true);
+
+        /**
+         * Used to check if the header has been written by a compatible version
+         * and if it matches the size of the mapping.
+         *
+         * @param siz       The size of the data buffer found in the file.
+         *
+         * @return          True if the header is compatible.
+         */
+        bool isCompatible(size_t siz);
+
+        /**
+         * Used to check if the header describes a valid fifo, which means it
+         * is compatible and the indices are within the data buffer.
+         *
+         * @param siz       The size of the data buffer found in the file.
+         *
+         * @return          True if the header is valid.
+         */
+        bool isValid(size_t siz);
+
+        /**
+         * Used to load both indices from the shared header and to check them.
+         *
+         * @param head      Takes the write index.
+         * @param tail      Takes the read index.
+         *
+         * @return          False if an index is out of range.
+         */
+        bool loadIndex(size_t *head, size_t *tail);
+
+        /**
+         * Used by the producer to load the indices, see loadIndex(). If 
+         * Checkpoint is set the read index of the last checkpoint is taken 
+         * instead of the current one, so free space is limited by it.
+         *
+         * @param head      Takes the write index.
+         * @param tail      Takes the read index which limits the free space.
+         *
+         * @return          False if an index is out of range.
+         */
+        bool loadWriteIndex(size_t *head, size_t *tail);
+
+        /**
+         * The mapped header.
+         */
+        Header *pHdr;
+
+        /**
+         * The mapped data buffer, which follows the header.
+         */
+        char *pData;
+
+        /**
+         * Local copy of the data buffer size, as the shared one can not be
+         * trusted.
+         */
+        size_t Size;
+
+        /**
+         * The file descriptor of the shared memory object.
+         */
+        int Fd;
+
+        /**
+         * Set if the producer has to keep the data of the last checkpoint, 
+         * see FileFifo::sync().
+         */
+        bool Checkpoint;
+
+    private:
+
+        ShmFifo(const ShmFifo &);
+        ShmFifo &operator=(const ShmFifo &);
+};
+
+#endif /* __linux__ */
+
+#endif /* GENERIC_SHMFIFO_HPP_ */
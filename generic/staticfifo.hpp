@@ -0,0 +1,338 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_STATICFIFO_HPP_
+#define GENERIC_STATICFIFO_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "generic/atomic.hpp"
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A fifo with a compile time capacity which owns its data buffer.
+ *
+ * Provides the same interface and the same single producer / single consumer
+ * guarantees as Fifo, but the capacity is a constant. The indices are free
+ * running counters, so all N bytes can be used and no byte is wasted to tell a
+ * full from an empty fifo.
+ *
+ * If N is a power of two the buffer index is derived by a bit mask, which
+ * removes all wrap around branches and divisions from put() and get(). For any
+ * other N the indices run in the range [0, 2N) and are wrapped by a compare.
+ *
+ *  StaticFifo<256> rxFifo;
+ *
+ *  void onRx(char c)
+ *  {
+ *      rxFifo.put(&c);
+ *  }
+ */
+template <size_t N> class StaticFifo
+{
+    public:
+
+        StaticFifo() :
+              Head(0)
+            , Tail(0)
+        {
+
+        }
+
+        /**
+         * To get the size of the fifo.
+         *
+         * @return The data buffer size in bytes.
+         */
+        static size_t getSize(void)
+        {
+            return N;
+        }
+
+        /**
+         * To get the amount of used fifo data buffer space.
+         *
+         * @return The number of used bytes.
+         */
+        size_t getUsed(void)
+        {
+            return distance(loadAcquire(Head), loadAcquire(Tail));
+        }
+
+        /**
+         * To get the amount of free fifo data buffer space.
+         *
+         * @return the number of free bytes.
+         */
+        size_t getFree(void)
+        {
+            return N - getUsed();
+        }
+
+        /**
+         * Used to write a given number of bytes from to the fifo.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz)
+        {
+            size_t head = Head;
+            size_t idx = index(head);
+            size_t avail = getFree();
+            size_t tmp = 0;
+
+            if (siz > avail)
+                siz = avail;
+
+            if (idx + siz > N)
+            {
+                tmp = N - idx;
+                memcpy(&Data[idx], buf, tmp);
+                memcpy(&Data[0], ((const char *)buf) + tmp, siz - tmp);
+            }
+            else
+            {
+                memcpy(&Data[idx], buf, siz);
+            }
+
+            storeRelease(Head, advance(head, siz));
+
+            return siz;
+        }
+
+        /**
+         * Used to get direct access to the free space of the fifo, to write
+         * data without copying it through write(). Data written to the block
+         * becomes visible to the consumer by calling commit().
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  free fifo space.
+         *
+         * @return          The number of bytes which can be written to the
+         *                  fifo in a subsequent way.
+         */
+        size_t getWriteBlock(void **buf)
+        {
+            size_t idx = index(Head);
+            size_t avail = getFree();
+
+            if (avail == 0)
+                return 0;
+
+            *buf = &Data[idx];
+
+            if (idx + avail > N)
+                avail = N - idx;
+
+            return avail;
+        }
+
+        /**
+         * Used to publish data which has been written to the space provided by
+         * getWriteBlock(). The function will commit not more bytes then free.
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz)
+        {
+            size_t avail = getFree();
+
+            if (siz > avail)
+                siz = avail;
+
+            storeRelease(Head, advance(Head, siz));
+        }
+
+        /**
+         * Used to put just one byte to the fifo.
+         *
+         * @param c         The byte to write to the fifo.
+         *
+         * @return The number of bytes written (0/1).
+         */
+        size_t put(const void *c)
+        {
+            size_t head = Head;
+
+            if (distance(head, loadAcquire(Tail)) == N)
+                return 0;
+
+            Data[index(head)] = *((const char *)c);
+            storeRelease(Head, advance(head, 1));
+
+            return 1;
+        }
+
+        /**
+         * Used to a single byte from the fifo to the provided buffer.
+         *
+         * @param buf       The target buffer to write to.
+         *
+         * @return          The number of bytes read.
+         */
+        size_t get(void *buf)
+        {
+            size_t tail = Tail;
+
+            if (loadAcquire(Head) == tail)
+                return 0;
+
+            *((char *)buf) = Data[index(tail)];
+            storeRelease(Tail, advance(tail, 1));
+
+            return 1;
+        }
+
+        /**
+         * Used to copy data from the fifo to the provided buffer.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       Number of bytes to read. Hence that less bytes then
+         *                  requested will be read from the fifo if less bytes
+         *                  are available.
+         *
+         * @return          The number of bytes read.
+         */
+        size_t read(void *buf, size_t siz)
+        {
+            size_t tail = Tail;
+            size_t idx = index(tail);
+            size_t avail = getUsed();
+            size_t tmp = 0;
+
+            if (siz > avail)
+                siz = avail;
+
+            if (idx + siz > N)
+            {
+                tmp = N - idx;
+                memcpy(buf, &Data[idx], tmp);
+                memcpy(((char *)buf) + tmp, &Data[0], siz - tmp);
+            }
+            else
+            {
+                memcpy(buf, &Data[idx], siz);
+            }
+
+            storeRelease(Tail, advance(tail, siz));
+
+            return siz;
+        }
+
+        /**
+         *
+         * @param buf       A pointer to a pointer to take the address of the
+         *                  fifo data
+         *
+         * @return          The number of bytes which can be read from the fifo
+         *                  in a subsequent way.
+         */
+        size_t getReadBlock(void **buf)
+        {
+            size_t idx = index(Tail);
+            size_t used = getUsed();
+
+            if (used == 0)
+                return 0;
+
+            *buf = &Data[idx];
+
+            if (idx + used > N)
+                used = N - idx;
+
+            return used;
+        }
+
+        /**
+         * Used to free space in the fifo. The function will free not more bytes
+         * then provided, but maybe less if less bytes are used.
+         *
+         * @param siz       Number of bytes to free.
+         */
+        void free(size_t siz)
+        {
+            size_t used = getUsed();
+
+            if (siz > used)
+                siz = used;
+
+            storeRelease(Tail, advance(Tail, siz));
+        }
+
+    private:
+
+        /**
+         * True if the buffer index can be derived by a bit mask.
+         */
+        static const bool IsPow2 = (N & (N - 1)) == 0;
+
+        static_assert(N > 0, "StaticFifo needs a capacity");
+
+        /**
+         * Maps a free running index to a position in the data buffer.
+         */
+        static size_t index(size_t pos)
+        {
+            return IsPow2 ? (pos & (N - 1)) : (pos >= N ? pos - N : pos);
+        }
+
+        /**
+         * Advances a free running index by n bytes, where n <= N.
+         */
+        static size_t advance(size_t pos, size_t n)
+        {
+            pos += n;
+
+            return IsPow2 ? pos : (pos >= 2 * N ? pos - 2 * N : pos);
+        }
+
+        /**
+         * The number of bytes between the given head and tail index.
+         */
+        static size_t distance(size_t head, size_t tail)
+        {
+            return IsPow2 ? head - tail : (head >= tail ?
+                head - tail : head + 2 * N - tail);
+        }
+
+        /**
+         * The data array.
+         */
+        char Data[N];
+
+        /**
+         * Write index, only modified by the producer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Head;
+
+        /**
+         * Read index, only modified by the consumer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Tail;
+};
+
+#endif /* GENERIC_STATICFIFO_HPP_ */
@@ -0,0 +1,260 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_TYPEDFIFO_HPP_
+#define GENERIC_TYPEDFIFO_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+#include "generic/atomic.hpp"
+#include "generic/fifo.hpp"
+
+/**
+ * @brief A fifo of N elements of type T.
+ * 
+ * Other than Fifo, which copies raw bytes, this class constructs every element
+ * in place in its own storage and moves it out again when it is taken from the
+ * fifo. So queuing non trivial objects never allocates and never copies them 
+ * twice. Like Fifo it is lock free for one producer and one consumer.
+ * 
+ * N has to be a power of two.
+ * 
+ *  struct Msg { uint8_t id; std::string text; Msg(uint8_t i, const char *t); };
+ *  TypedFifo<Msg, 16> msgs;
+ * 
+ *  msgs.emplace(1, "Hello");
+ * 
+ *  Msg msg;
+ *  while (msgs.tryPop(msg))
+ *      handle(msg);
+ */
+template <typename T, size_t N> class TypedFifo
+{
+    public:
+
+        TypedFifo() :
+              Head(0)
+            , Tail(0)
+        {
+
+        }
+
+        /**
+         * @brief Destroy the TypedFifo object including all queued elements.
+         */
+        ~TypedFifo()
+        {
+            while (Tail != Head)
+            {
+                slot(Tail++)->~T();
+            }
+        }
+
+        /**
+         * To get the capacity of the fifo.
+         *
+         * @return The number of elements the fifo can hold.
+         */
+        static size_t getSize(void)
+        {
+            return N;
+        }
+
+        /**
+         * To get the number of queued elements.
+         *
+         * @return The number of used elements.
+         */
+        size_t getUsed(void)
+        {
+            return loadAcquire(Head) - loadAcquire(Tail);
+        }
+
+        /**
+         * To get the number of free elements.
+         *
+         * @return The number of free elements.
+         */
+        size_t getFree(void)
+        {
+            return N - getUsed();
+        }
+
+        /**
+         * Used to add a copy of the given element to the fifo.
+         *
+         * @param val       The element to add.
+         *
+         * @return          True on success, false if the fifo is full.
+         */
+        bool push(const T &val)
+        {
+            return emplace(val);
+        }
+
+        /**
+         * Used to move the given element into the fifo.
+         *
+         * @param val       The element to move.
+         *
+         * @return          True on success, false if the fifo is full.
+         */
+        bool push(T &&val)
+        {
+            return emplace(std::move(val));
+        }
+
+        /**
+         * Used to construct a new element in place at the end of the fifo.
+         *
+         * @param args      The arguments passed to the constructor of T.
+         *
+         * @return          True on success, false if the fifo is full.
+         */
+        template <typename... Args> bool emplace(Args&&... args)
+        {
+            size_t head = Head;
+
+            if (head - loadAcquire(Tail) == N)
+                return false;
+
+            new (slot(head)) T(std::forward<Args>(args)...);
+            storeRelease(Head, head + 1);
+
+            return true;
+        }
+
+        /**
+         * Used to move up to n elements into the fifo.
+         *
+         * @param src       The elements to move, the moved elements are left
+         *                  in a valid but unspecified state.
+         * @param n         The number of elements.
+         *
+         * @return          The number of elements moved into the fifo.
+         */
+        size_t pushN(T *src, size_t n)
+        {
+            size_t head = Head;
+            size_t avail = getFree();
+
+            if (n > avail)
+                n = avail;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                new (slot(head + i)) T(std::move(src[i]));
+            }
+
+            storeRelease(Head, head + n);
+
+            return n;
+        }
+
+        /**
+         * Used to take the oldest element from the fifo.
+         *
+         * @param val       Takes the element by move assignment.
+         *
+         * @return          True on success, false if the fifo is empty.
+         */
+        bool tryPop(T &val)
+        {
+            size_t tail = Tail;
+            T *elem = 0;
+
+            if (loadAcquire(Head) == tail)
+                return false;
+
+            elem = slot(tail);
+            val = std::move(*elem);
+            elem->~T();
+            storeRelease(Tail, tail + 1);
+
+            return true;
+        }
+
+        /**
+         * Used to take up to n elements from the fifo.
+         *
+         * @param dst       Takes the elements by move assignment.
+         * @param n         The maximum number of elements to take.
+         *
+         * @return          The number of elements taken from the fifo.
+         */
+        size_t popN(T *dst, size_t n)
+        {
+            size_t tail = Tail;
+            size_t used = getUsed();
+
+            if (n > used)
+                n = used;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                T *elem = slot(tail + i);
+
+                dst[i] = std::move(*elem);
+                elem->~T();
+            }
+
+            storeRelease(Tail, tail + n);
+
+            return n;
+        }
+
+    private:
+
+        static_assert(N > 0 && (N & (N - 1)) == 0, 
+            "TypedFifo needs a power of two capacity");
+
+        TypedFifo(const TypedFifo &);
+        TypedFifo &operator=(const TypedFifo &);
+
+        /**
+         * Maps a free running index to the element storage.
+         */
+        T *slot(size_t pos)
+        {
+            return reinterpret_cast<T *>(&Storage[(pos & (N - 1)) * sizeof(T)]);
+        }
+
+        /**
+         * The raw element storage.
+         */
+        alignas(alignof(T)) unsigned char Storage[N * sizeof(T)];
+
+        /**
+         * Write index, only modified by the producer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Head;
+
+        /**
+         * Read index, only modified by the consumer.
+         */
+        alignas(FIFO_CACHELINE_SIZE) size_t Tail;
+};
+
+#endif /* GENERIC_TYPEDFIFO_HPP_ */
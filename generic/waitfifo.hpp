@@ -0,0 +1,211 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#ifndef GENERIC_WAITFIFO_HPP_
+#define GENERIC_WAITFIFO_HPP_
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "generic/fifo.hpp"
+
+/**
+ * @brief Adds blocking waits with watermarks to a Fifo, for Linux threads.
+ * 
+ * Instead of spinning on getUsed(), the consumer parks on a futex in
+ * waitData() until the fifo holds at least the high watermark of bytes or the
+ * timeout expires. The producer parks in waitSpace() until the consumer has
+ * drained the fifo down to the low watermark. Wakeups are only issued when a
+ * watermark is crossed and the other side is actually waiting, so under load
+ * the data is handed over in batches and no system call is made at all.
+ * 
+ * All data has to be passed through the write(), commit(), read() and free()
+ * functions of this class, as these issue the wakeups. Zero copy access is 
+ * possible through getFifo(). Like Fifo this class supports one producer and
+ * one consumer thread.
+ * 
+ *  void consumer(WaitFifo &wf)
+ *  {
+ *      char buf[256];
+ * 
+ *      wf.setWatermarks(0, sizeof(buf));
+ *      while (true)
+ *      {
+ *          wf.waitData(10);
+ *          process(buf, wf.read(buf, sizeof(buf)));
+ *      }
+ *  }
+ */
+class WaitFifo
+{
+    public:
+
+        /**
+         * @brief Construct a new WaitFifo object.
+         * 
+         * @param fifo      The fifo to operate on.
+         * @param low       The low watermark, see setWatermarks().
+         * @param high      The high watermark, see setWatermarks(). If it is
+         *                  invalid, the capacity of the fifo is used.
+         */
+        WaitFifo(Fifo &fifo, size_t low = 0, size_t high = 1);
+
+        /**
+         * Used to set the watermarks. The consumer is woken up if at least
+         * high bytes are available, the producer is woken up if not more than
+         * low bytes are used.
+         *
+         * @param low       The low watermark in bytes.
+         * @param high      The high watermark in bytes, not more than the 
+         *                  fifo can hold, which is its size - 1.
+         *
+         * @return          False if high is too large, the watermarks are 
+         *                  not changed then.
+         */
+        bool setWatermarks(size_t low, size_t high);
+
+        /**
+         * To get the fifo this object operates on.
+         *
+         * @return The fifo.
+         */
+        Fifo &getFifo(void);
+
+        /**
+         * Used to write data to the fifo, see Fifo::write(). Wakes up the 
+         * consumer if the high watermark has been reached.
+         *
+         * @param buf       The provided data.
+         * @param siz       The number of bytes to write.
+         *
+         * @return The number of written bytes.
+         */
+        size_t write(const void *buf, size_t siz);
+
+        /**
+         * Used to publish data written to the fifo directly, see 
+         * Fifo::commit(). Wakes up the consumer if the high watermark has been
+         * reached.
+         *
+         * @param siz       Number of bytes to commit.
+         */
+        void commit(size_t siz);
+
+        /**
+         * Used to read data from the fifo, see Fifo::read(). Wakes up the 
+         * producer if the low watermark has been reached.
+         *
+         * @param buf       The target buffer to write to.
+         * @param siz       Number of bytes to read.
+         *
+         * @return          The number of bytes read.
+         */
+        size_t read(void *buf, size_t siz);
+
+        /**
+         * Used to free data read from the fifo directly, see Fifo::free(). 
+         * Wakes up the producer if the low watermark has been reached.
+         *
+         * @param siz       Number of bytes to free.
+         */
+        void free(size_t siz);
+
+        /**
+         * Used by the consumer to wait until at least the high watermark of 
+         * bytes is available.
+         *
+         * @param timeout   The maximum time to wait in ms, -1 to wait forever.
+         *
+         * @return          The number of used bytes, which is less than the 
+         *                  high watermark if the timeout has expired.
+         */
+        size_t waitData(int timeout = -1);
+
+        /**
+         * Used by the producer to wait until not more than the low watermark
+         * of bytes is used.
+         *
+         * @param timeout   The maximum time to wait in ms, -1 to wait forever.
+         *
+         * @return          The number of free bytes.
+         */
+        size_t waitSpace(int timeout = -1);
+
+        /**
+         * Used to wake up a waiting consumer regardless of the watermark, e.g.
+         * at the end of a burst.
+         */
+        void flush(void);
+
+    private:
+
+        /**
+         * Wakes up the consumer if it waits and the high watermark is reached.
+         */
+        void notifyData(void);
+
+        /**
+         * Wakes up the producer if it waits and the low watermark is reached.
+         */
+        void notifySpace(void);
+
+        /**
+         * The fifo to operate on.
+         */
+        Fifo *pFifo;
+
+        /**
+         * The low watermark.
+         */
+        size_t Low;
+
+        /**
+         * The high watermark.
+         */
+        size_t High;
+
+        /**
+         * Futex word the consumer waits on, incremented on every wakeup.
+         */
+        alignas(FIFO_CACHELINE_SIZE) uint32_t DataSeq;
+
+        /**
+         * Set by the consumer while it waits.
+         */
+        uint32_t DataWaiting;
+
+        /**
+         * Futex word the producer waits on, incremented on every wakeup.
+         */
+        alignas(FIFO_CACHELINE_SIZE) uint32_t SpaceSeq;
+
+        /**
+         * Set by the producer while it waits.
+         */
+        uint32_t SpaceWaiting;
+};
+
+#endif /* __linux__ */
+
+#endif /* GENERIC_WAITFIFO_HPP_ */
@@ -0,0 +1,106 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#if defined(__linux__)
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "generic/mirrorfifo.hpp"
+
+MirrorFifo::MirrorFifo(void) :
+      Fifo()
+    , pMap(0)
+    , MapSize(0)
+{
+
+}
+
+MirrorFifo::~MirrorFifo(void)
+{
+    destroy();
+}
+
+bool MirrorFifo::create(size_t siz)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    void *addr = MAP_FAILED;
+    void *tmp = MAP_FAILED;
+    bool ret = false;
+    int fd = -1;
+
+    destroy();
+
+    siz = ((siz + page - 1) / page) * page;
+
+    if (siz == 0)
+        goto out;
+
+    fd = memfd_create("fifo", MFD_CLOEXEC);
+    if (fd < 0)
+        goto out;
+
+    if (ftruncate(fd, siz) != 0)
+        goto out;
+
+    /* Reserve the address space for both mappings first. */
+    addr = mmap(0, 2 * siz, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED)
+        goto out;
+
+    tmp = mmap(addr, siz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 
+        0);
+    if (tmp == MAP_FAILED)
+        goto out;
+
+    tmp = mmap((char *)addr + siz, siz, PROT_READ | PROT_WRITE, 
+        MAP_SHARED | MAP_FIXED, fd, 0);
+    if (tmp == MAP_FAILED)
+        goto out;
+
+    pMap = (char *)addr;
+    MapSize = siz;
+    init(pMap, MapSize, true);
+    ret = true;
+
+    out:
+    if (!ret && addr != MAP_FAILED)
+        munmap(addr, 2 * siz);
+
+    if (fd >= 0)
+        close(fd);
+
+    return ret;
+}
+
+void MirrorFifo::destroy(void)
+{
+    if (pMap == 0)
+        return;
+
+    init(0, 0);
+    munmap(pMap, 2 * MapSize);
+    pMap = 0;
+    MapSize = 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,366 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#if defined(__linux__)
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "generic/generic.hpp"
+#include "generic/shmfifo.hpp"
+
+/**
+ * Identifies a initialized shared memory fifo.
+ */
+#define SHMFIFO_MAGIC                   0x46494630
+
+ShmFifo::ShmFifo(void) :
+      pHdr(0)
+    , pData(0)
+    , Size(0)
+    , Fd(-1)
+    , Checkpoint(false)
+{
+
+}
+
+ShmFifo::~ShmFifo(void)
+{
+    close();
+}
+
+bool ShmFifo::create(const char *name, size_t siz)
+{
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (fd < 0)
+        return false;
+
+    return attach(fd, siz);
+}
+
+bool ShmFifo::create(size_t siz)
+{
+    int fd = memfd_create("shmfifo", MFD_CLOEXEC);
+
+    if (fd < 0)
+        return false;
+
+    return attach(fd, siz);
+}
+
+bool ShmFifo::open(const char *name)
+{
+    int fd = shm_open(name, O_RDWR, 0);
+
+    if (fd < 0)
+        return false;
+
+    return attach(fd, 0);
+}
+
+bool ShmFifo::open(int fd)
+{
+    fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+
+    if (fd < 0)
+        return false;
+
+    return attach(fd, 0);
+}
+
+void ShmFifo::close(void)
+{
+    if (pHdr)
+        munmap(pHdr, sizeof(Header) + Size);
+
+    if (Fd >= 0)
+        ::close(Fd);
+
+    pHdr = 0;
+    pData = 0;
+    Size = 0;
+    Fd = -1;
+    Checkpoint = false;
+}
+
+bool ShmFifo::unlink(const char *name)
+{
+    return shm_unlink(name) == 0;
+}
+
+int ShmFifo::getFd(void)
+{
+    return Fd;
+}
+
+size_t ShmFifo::getSize(void)
+{
+    return Size;
+}
+
+size_t ShmFifo::getUsed(void)
+{
+    size_t head = 0;
+    size_t tail = 0;
+
+    if (!loadIndex(&head, &tail))
+        return 0;
+
+    if (head >= tail)
+        return head - tail;
+
+    return head + (Size - tail);
+}
+
+size_t ShmFifo::getFree(void)
+{
+    size_t head = 0;
+    size_t tail = 0;
+
+    if (!loadWriteIndex(&head, &tail))
+        return 0;
+
+    if (head >= tail)
+        return Size - (head - tail) - 1;
+
+    return tail - head - 1;
+}
+
+size_t ShmFifo::write(const void *buf, size_t siz)
+{
+    size_t head = 0;
+    size_t tail = 0;
+    size_t avail = 0;
+    size_t tmp = 0;
+
+    if (!loadWriteIndex(&head, &tail))
+        return 0;
+
+    avail = head >= tail ? Size - (head - tail) - 1 : tail - head - 1;
+    siz = min(siz, avail);
+    tmp = min(siz, Size - head);
+
+    memcpy(&pData[head], buf, tmp);
+    memcpy(pData, ((const char *)buf) + tmp, siz - tmp);
+
+    commit(siz);
+
+    return siz;
+}
+
+size_t ShmFifo::getWriteBlock(void **buf)
+{
+    size_t head = 0;
+    size_t tail = 0;
+    size_t avail = 0;
+
+    if (!loadWriteIndex(&head, &tail))
+        return 0;
+
+    if (head >= tail)
+        avail = Size - head - (tail == 0 ? 1 : 0);
+    else
+        avail = tail - head - 1;
+
+    *buf = &pData[head];
+
+    return avail;
+}
+
+void ShmFifo::commit(size_t siz)
+{
+    size_t head = 0;
+    size_t tail = 0;
+    size_t avail = 0;
+
+    if (!loadWriteIndex(&head, &tail))
+        return;
+
+    avail = head >= tail ? Size - (head - tail) - 1 : tail - head - 1;
+    siz = min(siz, avail);
+    head += siz;
+
+    if (head >= Size)
+    {
+        head -= Size;
+    }
+
+    storeRelease(pHdr->Head, head);
+}
+
+size_t ShmFifo::read(void *buf, size_t siz)
+{
+    size_t head = 0;
+    size_t tail = 0;
+    size_t used = 0;
+    size_t tmp = 0;
+
+    if (!loadIndex(&head, &tail))
+        return 0;
+
+    used = head >= tail ? head - tail : head + (Size - tail);
+    siz = min(siz, used);
+    tmp = min(siz, Size - tail);
+
+    memcpy(buf, &pData[tail], tmp);
+    memcpy(((char *)buf) + tmp, pData, siz - tmp);
+
+    free(siz);
+
+    return siz;
+}
+
+size_t ShmFifo::getReadBlock(void **buf)
+{
+    size_t head = 0;
+    size_t tail = 0;
+
+    if (!loadIndex(&head, &tail))
+        return 0;
+
+    *buf = &pData[tail];
+
+    if (head >= tail)
+        return head - tail;
+
+    return Size - tail;
+}
+
+void ShmFifo::free(size_t siz)
+{
+    size_t head = 0;
+    size_t tail = 0;
+    size_t used = 0;
+
+    if (!loadIndex(&head, &tail))
+        return;
+
+    used = head >= tail ? head - tail : head + (Size - tail);
+    siz = min(siz, used);
+    tail += siz;
+
+    if (tail >= Size)
+    {
+        tail -= Size;
+    }
+
+    storeRelease(pHdr->Tail, tail);
+}
+
+bool ShmFifo::loadIndex(size_t *head, size_t *tail)
+{
+    *head = loadAcquire(pHdr->Head);
+    *tail = loadAcquire(pHdr->Tail);
+
+    /* Both indices are written by processes which might be broken. Indices out
+     * of range would make all copies exceed the buffer, so the fifo is used 
+     * as if it was empty and full until they are valid again. */
+    return *head < Size && *tail < Size;
+}
+
+bool ShmFifo::loadWriteIndex(size_t *head, size_t *tail)
+{
+    if (!loadIndex(head, tail))
+        return false;
+
+    if (!Checkpoint)
+        return true;
+
+    /* The data behind the checkpoint read index is needed for recovery, so the
+     * producer must not overwrite it before the next checkpoint. */
+    *tail = loadAcquire(pHdr->SyncTail);
+
+    return *tail < Size;
+}
+
+bool ShmFifo::attach(int fd, size_t siz, bool check)
+{
+    struct stat st;
+    void *addr = MAP_FAILED;
+    bool init = siz != 0;
+
+    close();
+
+    if (init)
+    {
+        if (ftruncate(fd, sizeof(Header) + siz) != 0)
+            goto err;
+    }
+    else
+    {
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size <= sizeof(Header))
+            goto err;
+
+        siz = st.st_size - sizeof(Header);
+    }
+
+    addr = mmap(0, sizeof(Header) + siz, PROT_READ | PROT_WRITE, MAP_SHARED, 
+        fd, 0);
+    if (addr == MAP_FAILED)
+        goto err;
+
+    pHdr = (Header *)addr;
+    pData = ((char *)addr) + sizeof(Header);
+    Size = siz;
+    Fd = fd;
+
+    if (init)
+    {
+        memset(pHdr, 0, sizeof(Header));
+        pHdr->Version = SHMFIFO_VERSION;
+        pHdr->Size = siz;
+        storeRelease(pHdr->Magic, SHMFIFO_MAGIC);
+    }
+    else if (check && !isValid(siz))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+
+    err:
+    ::close(fd);
+    return false;
+}
+
+bool ShmFifo::isCompatible(size_t siz)
+{
+    if (loadAcquire(pHdr->Magic) != SHMFIFO_MAGIC)
+        return false;
+
+    return pHdr->Version == SHMFIFO_VERSION && pHdr->Size == siz;
+}
+
+bool ShmFifo::isValid(size_t siz)
+{
+    if (!isCompatible(siz))
+        return false;
+
+    return pHdr->Head < siz && pHdr->Tail < siz;
+}
+
+#endif /* __linux__ */
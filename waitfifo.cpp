@@ -0,0 +1,262 @@
+/*
+ * libgeneric, a collection of usefool macros and classes to be used in any 
+ * kind of C/C++ project.
+ *
+ * Copyright (C) 2022 Julian Friedrich
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>. 
+ *
+ * You can file issues at https://github.com/fjulian79/libgeneric
+ */
+
+#if defined(__linux__)
+
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "generic/generic.hpp"
+#include "generic/waitfifo.hpp"
+
+/**
+ * Used to calculate the absolute deadline of a timeout in ms on the monotonic
+ * clock.
+ */
+static void getDeadline(struct timespec *deadline, int timeout)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+
+    if (timeout <= 0)
+        return;
+
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (timeout % 1000) * 1000000L;
+
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * Parks the calling thread on the given futex word as long as it holds val, 
+ * until it is woken up, a signal arrives or the deadline has passed. 
+ * 
+ * Returns false if the deadline has already passed.
+ */
+static bool park(uint32_t *word, uint32_t val, const struct timespec *deadline)
+{
+    struct timespec rel;
+    struct timespec *prel = 0;
+
+    if (deadline)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &rel);
+        rel.tv_sec = deadline->tv_sec - rel.tv_sec;
+        rel.tv_nsec = deadline->tv_nsec - rel.tv_nsec;
+
+        if (rel.tv_nsec < 0)
+        {
+            rel.tv_sec--;
+            rel.tv_nsec += 1000000000L;
+        }
+
+        if (rel.tv_sec < 0)
+            return false;
+
+        prel = &rel;
+    }
+
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, val, prel, 0, 0);
+
+    return true;
+}
+
+/**
+ * Wakes up the thread parked on the given futex word.
+ */
+static void unpark(uint32_t *word)
+{
+    addRelease(*word, 1);
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+}
+
+WaitFifo::WaitFifo(Fifo &fifo, size_t low, size_t high) :
+      pFifo(&fifo)
+    , Low(low)
+    , High(high)
+    , DataSeq(0)
+    , DataWaiting(0)
+    , SpaceSeq(0)
+    , SpaceWaiting(0)
+{
+    if (!setWatermarks(low, high))
+        High = fifo.getSize() - 1;
+}
+
+bool WaitFifo::setWatermarks(size_t low, size_t high)
+{
+    /* The fifo never holds more, waitData() would block forever. */
+    if (high > pFifo->getSize() - 1)
+        return false;
+
+    Low = low;
+    High = high;
+
+    return true;
+}
+
+Fifo &WaitFifo::getFifo(void)
+{
+    return *pFifo;
+}
+
+size_t WaitFifo::write(const void *buf, size_t siz)
+{
+    siz = pFifo->write(buf, siz);
+    notifyData();
+
+    return siz;
+}
+
+void WaitFifo::commit(size_t siz)
+{
+    pFifo->commit(siz);
+    notifyData();
+}
+
+size_t WaitFifo::read(void *buf, size_t siz)
+{
+    siz = pFifo->read(buf, siz);
+    notifySpace();
+
+    return siz;
+}
+
+void WaitFifo::free(size_t siz)
+{
+    pFifo->free(siz);
+    notifySpace();
+}
+
+size_t WaitFifo::waitData(int timeout)
+{
+    struct timespec deadline;
+    size_t used = pFifo->getUsed();
+    uint32_t seq = 0;
+
+    getDeadline(&deadline, timeout);
+
+    while (used < High)
+    {
+        /* 
+         * Announce the wait before checking the fifo once more. The producer
+         * checks the flag after publishing new data, so either it sees the 
+         * flag or this thread sees the data.
+         */
+        seq = loadAcquire(DataSeq);
+        storeRelaxed(DataWaiting, 1);
+        fullFence();
+
+        used = pFifo->getUsed();
+        if (used >= High)
+            break;
+
+        if (!park(&DataSeq, seq, timeout < 0 ? 0 : &deadline))
+            break;
+
+        used = pFifo->getUsed();
+        if (loadAcquire(DataSeq) != seq)
+            break;
+    }
+
+    storeRelaxed(DataWaiting, 0);
+
+    return used;
+}
+
+size_t WaitFifo::waitSpace(int timeout)
+{
+    struct timespec deadline;
+    size_t used = pFifo->getUsed();
+    uint32_t seq = 0;
+
+    getDeadline(&deadline, timeout);
+
+    while (used > Low)
+    {
+        /* Same handshake as in waitData(). */
+        seq = loadAcquire(SpaceSeq);
+        storeRelaxed(SpaceWaiting, 1);
+        fullFence();
+
+        used = pFifo->getUsed();
+        if (used <= Low)
+            break;
+
+        if (!park(&SpaceSeq, seq, timeout < 0 ? 0 : &deadline))
+            break;
+
+        used = pFifo->getUsed();
+        if (loadAcquire(SpaceSeq) != seq)
+            break;
+    }
+
+    storeRelaxed(SpaceWaiting, 0);
+
+    return pFifo->getFree();
+}
+
+void WaitFifo::flush(void)
+{
+    fullFence();
+
+    if (exchangeRelaxed(DataWaiting, 0))
+        unpark(&DataSeq);
+}
+
+void WaitFifo::notifyData(void)
+{
+    /* Pairs with the fence in waitData(). */
+    fullFence();
+
+    if (!loadRelaxed(DataWaiting))
+        return;
+
+    if (pFifo->getUsed() < High)
+        return;
+
+    if (exchangeRelaxed(DataWaiting, 0))
+        unpark(&DataSeq);
+}
+
+void WaitFifo::notifySpace(void)
+{
+    /* Pairs with the fence in waitSpace(). */
+    fullFence();
+
+    if (!loadRelaxed(SpaceWaiting))
+        return;
+
+    if (pFifo->getUsed() > Low)
+        return;
+
+    if (exchangeRelaxed(SpaceWaiting, 0))
+        unpark(&SpaceSeq);
+}
+
+#endif /* __linux__ */